@@ -33,253 +33,990 @@ Distributed as-is; no warranty is given.
 #include "alphaDisplay.h"
 #include "mcc_generated_files/system/system.h"
 #include "mcc_generated_files/timer/delay.h"
+#include "i2cQueue.h"
+#include "tick.h"
 #include <string.h>
 
-bool displayOnOff = 0;
-uint8_t blinkRate = ALPHA_BLINK_RATE_NOBLINK; // Tracks blink bits in display setup register
-uint8_t displayRAM[16];
-uint8_t digitPosition = 0;
-char displayContent[5];
-bool decimalOnOff = 0;
-bool colonOnOff = 0;
-// Linked List of character definitions
-//struct CharDef * pCharDefList = NULL;
-
 #define SFE_ALPHANUM_UNKNOWN_CHAR 95
+// Segment words for every printable glyph, in character order. Expanded below
+// into both the segment table and the per-digit display RAM row table, so the
+// two can never disagree.
+#define ALPHA_GLYPHS(X) \
+    /* nmlkjihgfedcba */ \
+    X(0b00000000000000) /* ' ' (space) */ \
+    X(0b00001000001000) /* '!' */ \
+    X(0b00001000000010) /* '"' */ \
+    X(0b01001101001110) /* '#' */ \
+    X(0b01001101101101) /* '$' */ \
+    X(0b10010000100100) /* '%' */ \
+    X(0b00110011011001) /* '&' */ \
+    X(0b00001000000000) /* ''' */ \
+    X(0b00000000111001) /* '(' */ \
+    X(0b00000000001111) /* ')' */ \
+    X(0b11111010000000) /* '*' */ \
+    X(0b01001101000000) /* '+' */ \
+    X(0b10000000000000) /* ',' */ \
+    X(0b00000101000000) /* '-' */ \
+    X(0b00000000000000) /* '.' */ \
+    X(0b10010000000000) /* '/' */ \
+    X(0b00000000111111) /* '0' */ \
+    X(0b00010000000110) /* '1' */ \
+    X(0b00000101011011) /* '2' */ \
+    X(0b00000101001111) /* '3' */ \
+    X(0b00000101100110) /* '4' */ \
+    X(0b00000101101101) /* '5' */ \
+    X(0b00000101111101) /* '6' */ \
+    X(0b01010000000001) /* '7' */ \
+    X(0b00000101111111) /* '8' */ \
+    X(0b00000101100111) /* '9' */ \
+    X(0b00000000000000) /* ':' */ \
+    X(0b10001000000000) /* ';' */ \
+    X(0b00110000000000) /* '<' */ \
+    X(0b00000101001000) /* '=' */ \
+    X(0b01000010000000) /* '>' */ \
+    X(0b01000100000011) /* '?' */ \
+    X(0b00001100111011) /* '@' */ \
+    X(0b00000101110111) /* 'A' */ \
+    X(0b01001100001111) /* 'B' */ \
+    X(0b00000000111001) /* 'C' */ \
+    X(0b01001000001111) /* 'D' */ \
+    X(0b00000101111001) /* 'E' */ \
+    X(0b00000101110001) /* 'F' */ \
+    X(0b00000100111101) /* 'G' */ \
+    X(0b00000101110110) /* 'H' */ \
+    X(0b01001000001001) /* 'I' */ \
+    X(0b00000000011110) /* 'J' */ \
+    X(0b00110001110000) /* 'K' */ \
+    X(0b00000000111000) /* 'L' */ \
+    X(0b00010010110110) /* 'M' */ \
+    X(0b00100010110110) /* 'N' */ \
+    X(0b00000000111111) /* 'O' */ \
+    X(0b00000101110011) /* 'P' */ \
+    X(0b00100000111111) /* 'Q' */ \
+    X(0b00100101110011) /* 'R' */ \
+    X(0b00000110001101) /* 'S' */ \
+    X(0b01001000000001) /* 'T' */ \
+    X(0b00000000111110) /* 'U' */ \
+    X(0b10010000110000) /* 'V' */ \
+    X(0b10100000110110) /* 'W' */ \
+    X(0b10110010000000) /* 'X' */ \
+    X(0b01010010000000) /* 'Y' */ \
+    X(0b10010000001001) /* 'Z' */ \
+    X(0b00000000111001) /* '[' */ \
+    X(0b00100010000000) /* '\' */ \
+    X(0b00000000001111) /* ']' */ \
+    X(0b10100000000000) /* '^' */ \
+    X(0b00000000001000) /* '_' */ \
+    X(0b00000010000000) /* '`' */ \
+    X(0b00000101011111) /* 'a' */ \
+    X(0b00100001111000) /* 'b' */ \
+    X(0b00000101011000) /* 'c' */ \
+    X(0b10000100001110) /* 'd' */ \
+    X(0b00000001111001) /* 'e' */ \
+    X(0b00000001110001) /* 'f' */ \
+    X(0b00000110001111) /* 'g' */ \
+    X(0b00000101110100) /* 'h' */ \
+    X(0b01000000000000) /* 'i' */ \
+    X(0b00000000001110) /* 'j' */ \
+    X(0b01111000000000) /* 'k' */ \
+    X(0b01001000000000) /* 'l' */ \
+    X(0b01000101010100) /* 'm' */ \
+    X(0b00100001010000) /* 'n' */ \
+    X(0b00000101011100) /* 'o' */ \
+    X(0b00010001110001) /* 'p' */ \
+    X(0b00100101100011) /* 'q' */ \
+    X(0b00000001010000) /* 'r' */ \
+    X(0b00000110001101) /* 's' */ \
+    X(0b00000001111000) /* 't' */ \
+    X(0b00000000011100) /* 'u' */ \
+    X(0b10000000010000) /* 'v' */ \
+    X(0b10100000010100) /* 'w' */ \
+    X(0b10110010000000) /* 'x' */ \
+    X(0b00001100001110) /* 'y' */ \
+    X(0b10010000001001) /* 'z' */ \
+    X(0b10000011001001) /* '{' */ \
+    X(0b01001000000000) /* '|' */ \
+    X(0b00110100001001) /* '}' */ \
+    X(0b00000101010010) /* '~' */ \
+    X(0b11111111111111) /* Unknown character (DEL or RUBOUT) */
+
+#define ALPHA_SEG_WORD(w) w,
 static const uint16_t alphanumeric_segs[] = {
-    // nmlkjihgfedcba
-    0b00000000000000, // ' ' (space)
-    0b00001000001000, // '!'
-    0b00001000000010, // '"'
-    0b01001101001110, // '#'
-    0b01001101101101, // '$'
-    0b10010000100100, // '%'
-    0b00110011011001, // '&'
-    0b00001000000000, // '''
-    0b00000000111001, // '('
-    0b00000000001111, // ')'
-    0b11111010000000, // '*'
-    0b01001101000000, // '+'
-    0b10000000000000, // ','
-    0b00000101000000, // '-'
-    0b00000000000000, // '.'
-    0b10010000000000, // '/'
-    0b00000000111111, // '0'
-    0b00010000000110, // '1'
-    0b00000101011011, // '2'
-    0b00000101001111, // '3'
-    0b00000101100110, // '4'
-    0b00000101101101, // '5'
-    0b00000101111101, // '6'
-    0b01010000000001, // '7'
-    0b00000101111111, // '8'
-    0b00000101100111, // '9'
-    0b00000000000000, // ':'
-    0b10001000000000, // ';'
-    0b00110000000000, // '<'
-    0b00000101001000, // '='
-    0b01000010000000, // '>'
-    0b01000100000011, // '?'
-    0b00001100111011, // '@'
-    0b00000101110111, // 'A'
-    0b01001100001111, // 'B'
-    0b00000000111001, // 'C'
-    0b01001000001111, // 'D'
-    0b00000101111001, // 'E'
-    0b00000101110001, // 'F'
-    0b00000100111101, // 'G'
-    0b00000101110110, // 'H'
-    0b01001000001001, // 'I'
-    0b00000000011110, // 'J'
-    0b00110001110000, // 'K'
-    0b00000000111000, // 'L'
-    0b00010010110110, // 'M'
-    0b00100010110110, // 'N'
-    0b00000000111111, // 'O'
-    0b00000101110011, // 'P'
-    0b00100000111111, // 'Q'
-    0b00100101110011, // 'R'
-    0b00000110001101, // 'S'
-    0b01001000000001, // 'T'
-    0b00000000111110, // 'U'
-    0b10010000110000, // 'V'
-    0b10100000110110, // 'W'
-    0b10110010000000, // 'X'
-    0b01010010000000, // 'Y'
-    0b10010000001001, // 'Z'
-    0b00000000111001, // '['
-    0b00100010000000, // '\'
-    0b00000000001111, // ']'
-    0b10100000000000, // '^'
-    0b00000000001000, // '_'
-    0b00000010000000, // '`'
-    0b00000101011111, // 'a'
-    0b00100001111000, // 'b'
-    0b00000101011000, // 'c'
-    0b10000100001110, // 'd'
-    0b00000001111001, // 'e'
-    0b00000001110001, // 'f'
-    0b00000110001111, // 'g'
-    0b00000101110100, // 'h'
-    0b01000000000000, // 'i'
-    0b00000000001110, // 'j'
-    0b01111000000000, // 'k'
-    0b01001000000000, // 'l'
-    0b01000101010100, // 'm'
-    0b00100001010000, // 'n'
-    0b00000101011100, // 'o'
-    0b00010001110001, // 'p'
-    0b00100101100011, // 'q'
-    0b00000001010000, // 'r'
-    0b00000110001101, // 's'
-    0b00000001111000, // 't'
-    0b00000000011100, // 'u'
-    0b10000000010000, // 'v'
-    0b10100000010100, // 'w'
-    0b10110010000000, // 'x'
-    0b00001100001110, // 'y'
-    0b10010000001001, // 'z'
-    0b10000011001001, // '{'
-    0b01001000000000, // '|'
-    0b00110100001001, // '}'
-    0b00000101010010, // '~'
-    0b11111111111111, // Unknown character (DEL or RUBOUT)
+    ALPHA_GLYPHS(ALPHA_SEG_WORD)
+};
+
+#if ALPHA_GLYPH_TABLE
+// Segments A-G drive COM0-COM6 on ROW0-3 (one row per digit). Segments H-N
+// drive ROW4-7, with H and I swapped onto COM1 and COM0. Every COM lives in
+// the even display RAM byte 2 * com, so a glyph at a digit is 7 row masks.
+#define ALPHA_COM_COUNT 7
+#define ALPHA_HIGH_SEG(com) ((com) == 0 ? 8 : (com) == 1 ? 7 : (com) + 7)
+#define ALPHA_ROW(w, digit, com) (uint8_t) ((((w) >> (com)) & 1) << (digit) | \
+                                           (((w) >> ALPHA_HIGH_SEG(com)) & 1) << ((digit) + 4))
+#define ALPHA_ROWS(w, digit) { ALPHA_ROW(w, digit, 0), ALPHA_ROW(w, digit, 1), ALPHA_ROW(w, digit, 2), \
+                               ALPHA_ROW(w, digit, 3), ALPHA_ROW(w, digit, 4), ALPHA_ROW(w, digit, 5), \
+                               ALPHA_ROW(w, digit, 6) },
+#define ALPHA_ROWS_DIGIT0(w) ALPHA_ROWS(w, 0)
+#define ALPHA_ROWS_DIGIT1(w) ALPHA_ROWS(w, 1)
+#define ALPHA_ROWS_DIGIT2(w) ALPHA_ROWS(w, 2)
+#define ALPHA_ROWS_DIGIT3(w) ALPHA_ROWS(w, 3)
+
+// Display RAM masks for [digit][glyph][com], generated by the compiler from ALPHA_GLYPHS
+static const uint8_t alphanumeric_rows[4][SFE_ALPHANUM_UNKNOWN_CHAR + 1][ALPHA_COM_COUNT] = {
+    { ALPHA_GLYPHS(ALPHA_ROWS_DIGIT0) },
+    { ALPHA_GLYPHS(ALPHA_ROWS_DIGIT1) },
+    { ALPHA_GLYPHS(ALPHA_ROWS_DIGIT2) },
+    { ALPHA_GLYPHS(ALPHA_ROWS_DIGIT3) },
 };
+#endif
 
-bool enableSystemClock() {
-    uint8_t data[1] = {};
-    data[0] = ALPHA_CMD_SYSTEM_SETUP | 1;
-    bool status = I2C1_Host_Write(DEFAULT_ADDRESS, data, 1);
+// User defined characters. customGlyphSlot is indexed by the character and
+// holds its slot + 1, or 0 for none, so a lookup is one array read.
+#define ALPHA_CUSTOM_CHARS 0x80
+static uint8_t customGlyphSlot[ALPHA_CUSTOM_CHARS];
+static uint8_t customGlyphChar[ALPHA_CUSTOM_GLYPHS]; // 0 when the slot is free
+#if ALPHA_GLYPH_TABLE
+static uint8_t customGlyphRows[ALPHA_CUSTOM_GLYPHS][4][ALPHA_COM_COUNT];
+#else
+static uint16_t customGlyphSegs[ALPHA_CUSTOM_GLYPHS];
+#endif
+
+// Queue the same one byte command for every display in the chain
+
+bool sendCommand(alpha_context_t *display, uint8_t command) {
+    bool status = true;
+
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++)
+        status &= I2CQueue_Write(display->displayBus[i], display->displayAddress[i], &command, 1);
+    return status;
+}
+
+// Settling times of the non-blocking bring up
+#define ALPHA_POWER_UP_TICKS (20 / ALPHA_TICK_MS)
+#define ALPHA_OSCILLATOR_TICKS (10 / ALPHA_TICK_MS)
+
+// Key data RAM holds one 16-bit word per K line, rows 0-12 in bits 0-12
+#define ALPHA_KEY_RAM 0x40
+#define ALPHA_KEY_ROW_MASK 0x1FFF
+
+// Blocks for the oscillator start; Alpha_StartupTick() waits it out in ticks instead
+
+bool enableSystemClock(alpha_context_t *display) {
+    bool status = sendCommand(display, ALPHA_CMD_SYSTEM_SETUP | 1);
     DELAY_milliseconds(10); // Allow display to start
     return (status);
 }
 
-bool setBrightness(uint8_t level) {
+// Writes go only to displays whose link is up; the others get everything
+// again when they answer a probe
+
+bool linkUp(alpha_context_t *display, uint8_t i) {
+    return display->linkState[i] == ALPHA_LINK_UP;
+}
+
+// Bring one control register up to date. Nothing is sent if the display
+// already has the wanted value; while the last write is still queued, later
+// changes only update controlWanted and go out together from Alpha_Tasks()
+
+bool flushControl(alpha_context_t *display, alpha_control_register_t reg) {
+    bool status = true;
+
+    if (display->controlWanted[reg] == display->controlSent[reg])
+        return true;
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++)
+        if (display->controlInFlight[reg][i])
+            return true;
+
+    display->controlCommand[reg] = display->controlWanted[reg];
+    display->controlSent[reg] = display->controlWanted[reg];
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++)
+        if (linkUp(display, i))
+            status &= I2CQueue_WriteBuffer(display->displayBus[i], display->displayAddress[i], &display->controlCommand[reg], 1,
+                                           &display->controlInFlight[reg][i], &display->linkError[i]);
+    if (!status)
+        display->controlSent[reg] = 0; // Queue full, Alpha_Tasks() sends it again
+    return status;
+}
+
+bool setBrightness(alpha_context_t *display, uint8_t level) {
     level = (level <= 15) ? level : 1;
-    uint8_t data[1] = {};
-    data[0] = ALPHA_CMD_DIMMING_SETUP | level;
-    return I2C1_Host_Write(DEFAULT_ADDRESS, data, 1);
+    display->controlWanted[ALPHA_REG_DIMMING] = ALPHA_CMD_DIMMING_SETUP | level;
+    return flushControl(display, ALPHA_REG_DIMMING);
+}
+// Blink rate and on/off share the display setup register
+
+bool updateDisplaySetup(alpha_context_t *display) {
+    display->controlWanted[ALPHA_REG_DISPLAY_SETUP] = ALPHA_CMD_DISPLAY_SETUP | (uint8_t) (display->blinkRate << 1) | display->displayOnOff;
+    return flushControl(display, ALPHA_REG_DISPLAY_SETUP);
 }
 
-bool setBlinkRate(float rate) {
+bool setBlinkRate(alpha_context_t *display, float rate) {
     if (rate == 2.0) {
-        blinkRate = ALPHA_BLINK_RATE_2HZ;
+        display->blinkRate = ALPHA_BLINK_RATE_2HZ;
     } else if (rate == 1.0) {
-        blinkRate = ALPHA_BLINK_RATE_1HZ;
+        display->blinkRate = ALPHA_BLINK_RATE_1HZ;
     } else if (rate == 0.5) {
-        blinkRate = ALPHA_BLINK_RATE_0_5HZ;
+        display->blinkRate = ALPHA_BLINK_RATE_0_5HZ;
     }//default to no blink
     else {
-        blinkRate = ALPHA_BLINK_RATE_NOBLINK;
+        display->blinkRate = ALPHA_BLINK_RATE_NOBLINK;
     }
-    uint8_t data[1] = {};
-    data[0] = ALPHA_CMD_DISPLAY_SETUP | (uint8_t) (blinkRate << 1) | displayOnOff;
-    return I2C1_Host_Write(DEFAULT_ADDRESS, data, 1);
+    return updateDisplaySetup(display);
 }
 
-bool setDisplayOnOff(bool turnOnDisplay) {
+bool setDisplayOnOff(alpha_context_t *display, bool turnOnDisplay) {
     if (turnOnDisplay) {
-        displayOnOff = ALPHA_DISPLAY_ON;
+        display->displayOnOff = ALPHA_DISPLAY_ON;
     } else {
-        displayOnOff = ALPHA_DISPLAY_OFF;
+        display->displayOnOff = ALPHA_DISPLAY_OFF;
     }
-    uint8_t data[1] = {};
-    data[0] = ALPHA_CMD_DISPLAY_SETUP | (uint8_t) (blinkRate << 1) | displayOnOff;
-    return I2C1_Host_Write(DEFAULT_ADDRESS, data, 1);
+    return updateDisplaySetup(display);
 }
-bool initialize() {
+bool initialize(alpha_context_t *display) {
     // Turn on system clock of all displays
-    enableSystemClock();
-    setBrightness(15);
-    setBlinkRate(ALPHA_BLINK_RATE_NOBLINK); 
-    setDisplayOnOff(true);
+    enableSystemClock(display);
+    setBrightness(display, 15);
+    setBlinkRate(display, ALPHA_BLINK_RATE_NOBLINK); 
+    setDisplayOnOff(display, true);
     return true;
 }
 
-bool isConnected() {
-    uint8_t triesBeforeGiveup = 5;
+// Tell the driver to use ROW15 as its INT output. Also replayed to a
+// display that comes back, in case it lost its setup.
 
-    for (uint8_t x = 0; x < triesBeforeGiveup; x++) {
-        //implement this if their are issues connecting with the display occasionally
-        //_i2cPort->beginTransmission(lookUpDisplayAddress(displayNumber));
-        //if (_i2cPort->endTransmission() == 0)
-        //{
-        return true;
-        //}
-        //delay(100);
+bool keyInterruptEnable(alpha_context_t *display) {
+    uint8_t i = display->keyDisplay;
+
+    display->keyRowIntCommand = ALPHA_CMD_ROW_INT_SET | 1;
+    return I2CQueue_WriteBuffer(display->displayBus[i], display->displayAddress[i], &display->keyRowIntCommand, 1, NULL,
+                                &display->linkError[i]);
+}
+
+// Send display i everything it may have missed while its link was down:
+// oscillator on, the control registers already sent to the others, and a
+// full frame
+
+bool replayDisplay(alpha_context_t *display, uint8_t i) {
+    bool status = I2CQueue_WriteBuffer(display->displayBus[i], display->displayAddress[i], &display->startupCommand, 1, NULL,
+                                       &display->linkError[i]);
+
+    for (uint8_t reg = 0; reg < ALPHA_CONTROL_REGISTERS; reg++)
+        if (display->controlSent[reg] != 0 && !display->controlInFlight[reg][i])
+            status &= I2CQueue_WriteBuffer(display->displayBus[i], display->displayAddress[i], &display->controlCommand[reg], 1,
+                                           &display->controlInFlight[reg][i], &display->linkError[i]);
+    if (display->keyInterrupt && display->keyDisplay == i)
+        status &= keyInterruptEnable(display);
+    display->sentRAMValid[i] = false;
+    return status && updateDisplay(display);
+}
+
+// Contexts bound so far, so a rescan never takes over an address that
+// belongs to another display on the same bus
+static alpha_context_t *boundDisplays = NULL;
+
+bool addressClaimed(alpha_context_t *display, uint8_t index, uint8_t address) {
+    for (alpha_context_t *other = boundDisplays; other != NULL; other = other->next)
+        for (uint8_t i = 0; i < other->numberOfDisplays; i++)
+            if (other->displayBus[i] == display->displayBus[index] && other->displayAddress[i] == address &&
+                    (other != display || i != index))
+                return true;
+    return false;
+}
+
+bool probeAddress(alpha_context_t *display, uint8_t i, uint8_t address) {
+    display->probeError[i] = I2C_ERROR_NONE;
+    display->scanAddress[i] = 0;
+    if (!I2CQueue_WriteBuffer(display->displayBus[i], address, NULL, 0, &display->probeInFlight[i], &display->probeError[i]))
+        return false;
+    display->scanAddress[i] = address;
+    return true;
+}
+
+// Probe the next address of the scan: the display's own first, then every
+// free one. False once the scan has run out of addresses.
+
+bool scanNext(alpha_context_t *display, uint8_t i) {
+    while (display->scanStep[i] <= ALPHA_ADDRESS_LAST - ALPHA_ADDRESS_FIRST + 1) {
+        uint8_t address = display->scanStep[i] == 0 ? display->displayAddress[i] : ALPHA_ADDRESS_FIRST + display->scanStep[i] - 1;
+
+        if (display->scanStep[i] > 0 && (address == display->displayAddress[i] || addressClaimed(display, i, address))) {
+            display->scanStep[i]++;
+            continue;
+        }
+        if (probeAddress(display, i, address))
+            display->scanStep[i]++;
+        return true; // Else queue full, same address on the next tick
     }
     return false;
 }
 
-void shiftArray(uint8_t *original, uint8_t *shifted) {
-    shifted[0] = 0; // Or any other desired value for the first element
-    memcpy(shifted + 1, original, 16 * sizeof (uint8_t));
+// Read back the key data RAM of the device that answered at scanAddress
+// before taking it over. The pointer byte is the only thing written to it.
+
+bool verifyAddress(alpha_context_t *display, uint8_t i) {
+    display->probeError[i] = I2C_ERROR_NONE;
+    display->verifyPointer = ALPHA_KEY_RAM;
+    memset(display->verifyRAM[i], 0xFF, sizeof (display->verifyRAM[i]));
+    return I2CQueue_WriteRead(display->displayBus[i], display->scanAddress[i], &display->verifyPointer, 1, display->verifyRAM[i],
+                              sizeof (display->verifyRAM[i]), &display->probeInFlight[i], &display->probeError[i]);
+}
+
+// An HT16K33 has 13 rows per K line, so bits 13-15 of every key data word
+// read 0. An I2C switch such as the PCA9548 echoes the 0x40 just written,
+// and a bus nobody drives reads 0xFF, so neither passes.
+
+bool isHT16K33(const uint8_t *keyRAM) {
+    for (uint8_t k = 0; k < 3; k++)
+        if ((keyRAM[2 * k] | keyRAM[2 * k + 1] << 8) & ~ALPHA_KEY_ROW_MASK)
+            return false;
+    return true;
 }
 
-bool updateDisplay() {
-    uint8_t msg[17];
-    shiftArray(displayRAM, msg);
-    return I2C1_Host_Write(DEFAULT_ADDRESS, msg, 16);
+void linkScan(alpha_context_t *display, uint8_t i, uint8_t firstStep) {
+    display->scanStep[i] = firstStep;
+    display->scanAddress[i] = 0;
+    display->linkState[i] = ALPHA_LINK_SCANNING;
 }
 
-bool clear() {
-    for (uint8_t i = 0; i < 16; i++)
-        displayRAM[i] = 0;
-    digitPosition = 0;
+// The display answered at scanAddress: keep using it until it fails again,
+// and send it everything it may have missed
+
+void linkRecovered(alpha_context_t *display, uint8_t i) {
+    display->displayAddress[i] = display->scanAddress[i];
+    display->linkError[i] = I2C_ERROR_NONE; // Failures of writes queued before the probe
+    display->linkState[i] = ALPHA_LINK_UP;
+    if (!replayDisplay(display, i)) {
+        display->linkBackoff[i] = ALPHA_RETRY_MS / ALPHA_TICK_MS; // Queue full, probe and replay again
+        display->linkState[i] = ALPHA_LINK_BACKOFF;
+    }
+}
 
-    return (updateDisplay());
+void linkRetry(alpha_context_t *display, uint8_t i) {
+    if (++display->linkRetries[i] >= ALPHA_RETRY_LIMIT) {
+        display->linkState[i] = ALPHA_LINK_DOWN;
+        return;
+    }
+    display->linkBackoff[i] = (uint16_t) ((ALPHA_RETRY_MS / ALPHA_TICK_MS) << display->linkRetries[i]);
+    display->linkState[i] = ALPHA_LINK_BACKOFF;
 }
 
-bool Alpha_Begin(void) {
+// A failed write starts the retry cycle. An address NACK means the ADR pins
+// may have moved the driver, so the other addresses are searched straight
+// away; other errors wait, probe the address with a zero-length write, and
+// double the wait after every probe or scan that finds nothing. A new address
+// is only taken once its key data RAM reads back like an HT16K33's. The
+// address found is kept, so nothing is scanned while writes succeed. Runs on
+// ticks, so a missing display never blocks the loop.
+
+void Alpha_LinkTick(alpha_context_t *display) {
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++) {
+        if (display->linkBackoff[i] > 0)
+            display->linkBackoff[i]--;
+
+        switch (display->linkState[i]) {
+            case ALPHA_LINK_UP:
+                if (display->linkError[i] == I2C_ERROR_NONE)
+                    break;
+                display->sentRAMValid[i] = false; // Unknown what reached the driver
+                display->linkRetries[i] = 0;
+                if (display->linkError[i] == I2C_ERROR_ADDR_NACK) {
+                    linkScan(display, i, 0);
+                    break;
+                }
+                display->linkBackoff[i] = ALPHA_RETRY_MS / ALPHA_TICK_MS;
+                display->linkState[i] = ALPHA_LINK_BACKOFF;
+                break;
+            case ALPHA_LINK_BACKOFF:
+                if (display->linkBackoff[i] > 0)
+                    break;
+                if (probeAddress(display, i, display->displayAddress[i]))
+                    display->linkState[i] = ALPHA_LINK_PROBING; // Else queue full, try on the next tick
+                break;
+            case ALPHA_LINK_PROBING:
+                if (display->probeInFlight[i])
+                    break;
+                if (display->probeError[i] == I2C_ERROR_NONE)
+                    linkRecovered(display, i);
+                else if (display->probeError[i] == I2C_ERROR_ADDR_NACK)
+                    linkScan(display, i, 1); // Own address just failed, search the others
+                else
+                    linkRetry(display, i);
+                break;
+            case ALPHA_LINK_SCANNING:
+                if (display->probeInFlight[i])
+                    break;
+                if (display->scanAddress[i] != 0 && display->probeError[i] == I2C_ERROR_NONE) {
+                    if (display->scanAddress[i] == display->displayAddress[i])
+                        linkRecovered(display, i);
+                    else if (verifyAddress(display, i))
+                        display->linkState[i] = ALPHA_LINK_VERIFYING; // Else queue full, try on the next tick
+                } else if (!scanNext(display, i))
+                    linkRetry(display, i);
+                break;
+            case ALPHA_LINK_VERIFYING:
+                if (display->probeInFlight[i])
+                    break;
+                if (display->probeError[i] == I2C_ERROR_NONE && isHT16K33(display->verifyRAM[i])) {
+                    linkRecovered(display, i);
+                    break;
+                }
+                display->scanAddress[i] = 0; // Not our display, go on with the next address
+                display->linkState[i] = ALPHA_LINK_SCANNING;
+                break;
+            case ALPHA_LINK_DOWN:
+                break;
+        }
+    }
+}
 
-    DELAY_milliseconds(20);
-    initialize();
-    clear();
-    displayContent[4] = '\0'; // Terminate the array because we are doing direct prints
+bool isConnected(alpha_context_t *display) {
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++)
+        if (!linkUp(display, i))
+            return false;
     return true;
 }
-// Set or clear the decimal on/off bit
 
-bool setDecimalOnOff(bool turnOnDecimal, bool updateNow) {
-    uint8_t adr = 0x03;
+void Alpha_Reconnect(alpha_context_t *display) {
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++) {
+        if (display->linkState[i] != ALPHA_LINK_DOWN)
+            continue;
+        display->linkRetries[i] = 0;
+        display->linkBackoff[i] = 0;
+        display->linkState[i] = ALPHA_LINK_BACKOFF;
+    }
+}
+
+// Fletcher checksum of one display's 16 RAM bytes, sensitive to byte order
+
+uint16_t ramChecksum(const uint8_t *ram) {
+    uint8_t sum = 0;
+    uint8_t sumOfSums = 0;
+
+    for (uint8_t i = 0; i < 16; i++) {
+        sum += ram[i];
+        sumOfSums += sum;
+    }
+    return (uint16_t) (sumOfSums << 8 | sum);
+}
+
+// Check a finished read back. If the driver holds something else than what
+// was sent, take its RAM as the sent copy so the dirty-span update rewrites
+// just the bytes that differ.
+
+void scrubCheck(alpha_context_t *display, uint8_t i) {
+    uint8_t *sent = display->sentRAM + i * 16;
+
+    if (display->scrubStale || !linkUp(display, i) || display->linkError[i] != I2C_ERROR_NONE || !display->sentRAMValid[i])
+        return; // Nothing known to compare with
+    if (ramChecksum(display->scrubRAM) == ramChecksum(sent))
+        return;
+    display->scrubRepairs++;
+    memcpy(sent, display->scrubRAM, sizeof (display->scrubRAM));
+    updateDisplay(display);
+}
+
+void Alpha_ScrubStart(alpha_context_t *display, uint16_t ticksPerRead) {
+    display->scrubTicksPerRead = ticksPerRead;
+    display->scrubCountdown = ticksPerRead;
+}
+
+void Alpha_ScrubStop(alpha_context_t *display) {
+    display->scrubTicksPerRead = 0;
+}
+
+// Run by Alpha_Tasks() once per display tick. A display is only read back
+// while nothing is on its way to it; otherwise it is tried on the next tick.
+
+void Alpha_ScrubTick(alpha_context_t *display) {
+    if (display->scrubInFlight)
+        return;
+    if (display->scrubReading) {
+        display->scrubReading = false;
+        scrubCheck(display, display->scrubIndex);
+        display->scrubIndex = (display->scrubIndex + 1) % display->numberOfDisplays;
+    }
+    if (display->scrubTicksPerRead == 0 || !Alpha_IsReady(display))
+        return;
+    if (display->scrubCountdown > 1) {
+        display->scrubCountdown--;
+        return;
+    }
+
+    uint8_t i = display->scrubIndex;
+    if (!linkUp(display, i) || !display->sentRAMValid[i] || display->frameInFlight[i] || display->backLength[i] != 0)
+        return;
+    display->scrubPointer = 0x00;
+    display->scrubStale = false;
+    if (!I2CQueue_WriteRead(display->displayBus[i], display->displayAddress[i], &display->scrubPointer, 1, display->scrubRAM,
+                            sizeof (display->scrubRAM), &display->scrubInFlight, &display->linkError[i]))
+        return; // Queue full, next tick
+    display->scrubReading = true;
+    display->scrubCountdown = display->scrubTicksPerRead;
+}
+
+#if ALPHA_KEY_EVENTS & (ALPHA_KEY_EVENTS - 1) || ALPHA_KEY_EVENTS > 128
+#error "ALPHA_KEY_EVENTS must be a power of 2 no larger than 128"
+#endif
+
+// Producer side of the event ring. The slot is filled before keyHead moves,
+// so the consumer never sees a half written event; free running indices
+// tell a full ring from an empty one.
+
+void keyEventPut(alpha_context_t *display, uint8_t key, bool pressed) {
+    uint8_t head = display->keyHead;
+
+    if ((uint8_t) (head - display->keyTail) == ALPHA_KEY_EVENTS) {
+        display->keyOverflows++;
+        return;
+    }
+    display->keyEvents[head % ALPHA_KEY_EVENTS].key = key;
+    display->keyEvents[head % ALPHA_KEY_EVENTS].pressed = pressed;
+    display->keyHead = head + 1;
+}
+
+// Debounce a finished key RAM read: a change is only taken once the same
+// matrix has been read ALPHA_KEY_DEBOUNCE times in a row
+
+void keyscanCheck(alpha_context_t *display) {
+    uint8_t i = display->keyDisplay;
+    uint16_t raw[ALPHA_KEY_COLUMNS];
+
+    if (!linkUp(display, i) || display->linkError[i] != I2C_ERROR_NONE)
+        return; // Read failed, keep what is known
+    for (uint8_t k = 0; k < ALPHA_KEY_COLUMNS; k++)
+        raw[k] = (uint16_t) (display->keyRAM[2 * k] | display->keyRAM[2 * k + 1] << 8) & ALPHA_KEY_ROW_MASK;
+    if (memcmp(raw, display->keyRaw, sizeof (raw)) != 0) {
+        memcpy(display->keyRaw, raw, sizeof (raw));
+        display->keyAgreement = 1;
+    } else if (display->keyAgreement < ALPHA_KEY_DEBOUNCE) {
+        display->keyAgreement++;
+    }
+    if (display->keyAgreement < ALPHA_KEY_DEBOUNCE)
+        return;
+
+    for (uint8_t k = 0; k < ALPHA_KEY_COLUMNS; k++) {
+        uint16_t changed = raw[k] ^ display->keyState[k];
+
+        for (uint8_t row = 0; changed != 0; row++, changed >>= 1)
+            if (changed & 1)
+                keyEventPut(display, (uint8_t) (ALPHA_KEY_ROWS * k + row), (raw[k] >> row) & 1);
+        display->keyState[k] = raw[k];
+    }
+}
+
+bool Alpha_KeyscanStart(alpha_context_t *display, uint8_t displayNumber, uint16_t ticksPerPoll) {
+    if (displayNumber >= display->numberOfDisplays)
+        return false;
+    display->keyDisplay = displayNumber;
+    memset(display->keyRaw, 0, sizeof (display->keyRaw));
+    memset(display->keyState, 0, sizeof (display->keyState));
+    display->keyAgreement = 0;
+    display->keyInterrupt = false;
+    display->keyTicksPerPoll = ticksPerPoll;
+    display->keyCountdown = ticksPerPoll;
+    return true;
+}
+
+bool Alpha_KeyscanInterruptStart(alpha_context_t *display, uint8_t displayNumber, uint16_t ticksPerPoll) {
+    if (!Alpha_KeyscanStart(display, displayNumber, ticksPerPoll) || !keyInterruptEnable(display))
+        return false;
+    display->keyInterrupt = true;
+    display->keyWake = true; // Read once, a key may already be down
+    return true;
+}
+
+void Alpha_KeyInterrupt(alpha_context_t *display) {
+    display->keyWake = true;
+}
+
+void Alpha_KeyscanStop(alpha_context_t *display) {
+    display->keyTicksPerPoll = 0;
+    display->keyInterrupt = false;
+}
+
+// Nothing to poll for: no key down, debounced or not
+
+bool keysIdle(alpha_context_t *display) {
+    if (display->keyAgreement < ALPHA_KEY_DEBOUNCE)
+        return false;
+    for (uint8_t k = 0; k < ALPHA_KEY_COLUMNS; k++)
+        if (display->keyRaw[k] != 0 || display->keyState[k] != 0)
+            return false;
+    return true;
+}
+
+// Run by Alpha_Tasks() once per display tick. A poll is one queued
+// WriteRead: the key RAM address, then the 6 bytes of K1-K3.
+
+void Alpha_KeyscanTick(alpha_context_t *display) {
+    if (display->keyInFlight)
+        return;
+    if (display->keyReading) {
+        display->keyReading = false;
+        keyscanCheck(display);
+    }
+    if (display->keyTicksPerPoll == 0 || !Alpha_IsReady(display))
+        return;
+    if (display->keyCountdown > 1) {
+        display->keyCountdown--;
+        return;
+    }
+    if (display->keyInterrupt && !display->keyWake && keysIdle(display))
+        return; // Countdown stays expired, so an interrupt is served at once
+
+    uint8_t i = display->keyDisplay;
+    if (!linkUp(display, i))
+        return;
+    display->keyWake = false; // Before the read, so a later interrupt is not lost
+    display->keyPointer = ALPHA_KEY_RAM;
+    if (!I2CQueue_WriteRead(display->displayBus[i], display->displayAddress[i], &display->keyPointer, 1, display->keyRAM,
+                            sizeof (display->keyRAM), &display->keyInFlight, &display->linkError[i]))
+        return; // Queue full, next tick
+    display->keyReading = true;
+    display->keyCountdown = display->keyTicksPerPoll;
+}
+
+// Consumer side of the event ring
+
+bool Alpha_KeyEventGet(alpha_context_t *display, alpha_key_event_t *event) {
+    uint8_t tail = display->keyTail;
+
+    if (tail == display->keyHead)
+        return false;
+    *event = display->keyEvents[tail % ALPHA_KEY_EVENTS];
+    display->keyTail = tail + 1;
+    return true;
+}
+
+// Copy length RAM bytes starting at first behind the RAM address they start at
+
+void shiftArray(uint8_t *original, uint8_t *shifted, uint8_t first, uint8_t length) {
+    shifted[0] = first; // HT16K33 auto-increments the address pointer from here
+    memcpy(shifted + 1, original + first, length * sizeof (uint8_t));
+}
+// Queue each display's back frame once its front frame has been fully clocked out.
+// A front frame stays untouched until then because the I2C ISR reads it in place.
+
+bool flushFrame(alpha_context_t *display) {
+    bool status = true;
+
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++) {
+        if (!linkUp(display, i)) {
+            display->backLength[i] = 0; // Sent in full once the display answers again
+            continue;
+        }
+        if (display->frameInFlight[i] || display->backLength[i] == 0)
+            continue; // Back frame waits for the next poll, or there is nothing to send
+
+        uint8_t *back = display->frameBuffer[i][display->frontFrame[i] ^ 1];
+        if (!I2CQueue_WriteBuffer(display->displayBus[i], display->displayAddress[i], back, display->backLength[i], &display->frameInFlight[i],
+                                  &display->linkError[i])) {
+            status = false; // Queue full, retried on the next poll
+            continue;
+        }
+
+        // Swap: the back frame is now what the driver will hold once the transfer ends
+        display->frontFrame[i] ^= 1;
+        if (display->scrubReading && display->scrubIndex == i)
+            display->scrubStale = true; // The read back predates this frame
+        memcpy(display->sentRAM + i * 16 + back[0], back + 1, (display->backLength[i] - 1) * sizeof (uint8_t));
+        display->sentRAMValid[i] = true;
+        display->backLength[i] = 0;
+    }
+    return status;
+}
+// Build each display's back frame from the span of its RAM that differs from
+// the driver's RAM, then queue all of them back-to-back in one burst.
+// A newer update replaces a frame still waiting.
+
+bool updateDisplay(alpha_context_t *display) {
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++) {
+        uint8_t *ram = display->displayRAM + i * 16;
+        uint8_t *sent = display->sentRAM + i * 16;
+        uint8_t first = 0;
+        uint8_t last = 15;
+
+        if (display->sentRAMValid[i]) {
+            while (first < 16 && ram[first] == sent[first])
+                first++;
+            if (first == 16) {
+                display->backLength[i] = 0; // Nothing changed, leave the bus alone
+                continue;
+            }
+            while (ram[last] == sent[last])
+                last--;
+        }
+
+        uint8_t length = last - first + 1;
+        shiftArray(ram, display->frameBuffer[i][display->frontFrame[i] ^ 1], first, length);
+        display->backLength[i] = length + 1;
+    }
+    return flushFrame(display);
+}
+
+void Alpha_Tasks(alpha_context_t *display) {
+    uint32_t now = Tick_Get();
+    uint32_t behind = (uint32_t) (now - display->lastTick) / ALPHA_TICK_MS;
+
+    // Catch up on the ticks since the last call, so timing holds when the loop
+    // runs late, but on no more than ALPHA_CATCH_UP_TICKS after a long stall
+    if (behind > ALPHA_CATCH_UP_TICKS)
+        display->lastTick += (behind - ALPHA_CATCH_UP_TICKS) * ALPHA_TICK_MS;
+    while ((uint32_t) (now - display->lastTick) >= ALPHA_TICK_MS) {
+        display->lastTick += ALPHA_TICK_MS;
+        Alpha_StartupTick(display);
+        Alpha_LinkTick(display);
+        Alpha_ScrubTick(display);
+        Alpha_KeyscanTick(display);
+        Alpha_ScrollTick(display);
+    }
+    I2CQueue_Tasks();
+    flushControl(display, ALPHA_REG_DIMMING);
+    flushControl(display, ALPHA_REG_DISPLAY_SETUP);
+    flushFrame(display);
+}
+
+bool clear(alpha_context_t *display) {
+    for (uint8_t i = 0; i < 16 * display->numberOfDisplays; i++)
+        display->displayRAM[i] = 0;
+    display->digitPosition = 0;
+
+    return (updateDisplay(display));
+}
+
+// Take the context off the list of bound contexts, if it is on it
+
+void unbindContext(alpha_context_t *display) {
+    for (alpha_context_t **link = &boundDisplays; *link != NULL; link = &(*link)->next)
+        if (*link == display) {
+            *link = display->next;
+            break;
+        }
+    display->next = NULL;
+}
+
+// Reset the context and attach each display to its bus and address
+
+bool bindContext(alpha_context_t *display, const i2c_host_interface_t *const *buses, const uint8_t *addresses, uint8_t count) {
+    if (count == 0 || count > ALPHA_MAX_DISPLAYS)
+        return false;
+
+    unbindContext(display); // Listed once however often it is begun
+    memset(display, 0, sizeof (*display)); // Driver RAM is undefined after power up, send all of it
+    display->next = boundDisplays;
+    boundDisplays = display;
+    display->blinkRate = ALPHA_BLINK_RATE_NOBLINK;
+    display->numberOfDisplays = count;
+    for (uint8_t i = 0; i < count; i++) {
+        display->displayBus[i] = buses[i];
+        display->displayAddress[i] = addresses[i];
+    }
+    display->displayContent[4 * count] = '\0'; // Terminate the array because we are doing direct prints
+    display->lastTick = Tick_Get();
+    display->startupCommand = ALPHA_CMD_SYSTEM_SETUP | 1; // Also replayed to a display that comes back
+
+    // Queued transfers chain from their own completion callbacks. The transfer
+    // done callback also resumes the queue after other clients of the bus;
+    // other buses have to register I2CQueue_TransferDone for that themselves.
+    for (uint8_t i = 0; i < count; i++)
+        if (buses[i] == &ALPHA_I2C_HOST) {
+            ALPHA_I2C_DONE_REGISTER(I2CQueue_TransferDone);
+            break;
+        }
+    return true;
+}
+
+// Bus list for a chain that sits on one bus
+
+void busesFill(const i2c_host_interface_t **buses, const i2c_host_interface_t *bus) {
+    for (uint8_t i = 0; i < ALPHA_MAX_DISPLAYS; i++)
+        buses[i] = bus;
+}
+
+bool Alpha_BeginChain(alpha_context_t *display, const i2c_host_interface_t *bus, const uint8_t *addresses, uint8_t count) {
+    const i2c_host_interface_t *buses[ALPHA_MAX_DISPLAYS];
+
+    busesFill(buses, bus);
+    if (!bindContext(display, buses, addresses, count))
+        return false;
+
+    DELAY_milliseconds(20); // Power up, Alpha_BeginAsync() waits it out in ticks instead
+    initialize(display);
+    clear(display);
+    display->startupState = ALPHA_STARTUP_READY;
+    return true;
+}
+
+bool Alpha_BeginAsync(alpha_context_t *display, const i2c_host_interface_t *bus, const uint8_t *addresses, uint8_t count,
+        void (*ready)(alpha_context_t *display)) {
+    const i2c_host_interface_t *buses[ALPHA_MAX_DISPLAYS];
+
+    busesFill(buses, bus);
+    return Alpha_BeginAsyncBuses(display, buses, addresses, count, ready);
+}
+
+bool Alpha_BeginAsyncBuses(alpha_context_t *display, const i2c_host_interface_t *const *buses, const uint8_t *addresses, uint8_t count,
+        void (*ready)(alpha_context_t *display)) {
+    if (!bindContext(display, buses, addresses, count))
+        return false;
+
+    display->startupState = ALPHA_STARTUP_POWER_UP;
+    display->startupTicks = ALPHA_POWER_UP_TICKS;
+    display->startupReady = ready;
+    return true;
+}
+// True once a control register write has left the queue on every display
+
+bool controlSettled(alpha_context_t *display, alpha_control_register_t reg) {
+    flushControl(display, reg); // Retry if the queue was full
+    if (display->controlSent[reg] != display->controlWanted[reg])
+        return false;
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++)
+        if (display->controlInFlight[reg][i])
+            return false;
+    return true;
+}
+// True once the last frame has left the queue on every display
+
+bool frameSettled(alpha_context_t *display) {
+    flushFrame(display);
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++)
+        if (display->frameInFlight[i] || display->backLength[i] != 0)
+            return false;
+    return true;
+}
+// One step of the bring up per call: each waits for its settling time and
+// for the previous command to leave the queue, so nothing is dropped
+
+void Alpha_StartupTick(alpha_context_t *display) {
+    if (display->startupTicks > 0)
+        display->startupTicks--;
+
+    switch (display->startupState) {
+        case ALPHA_STARTUP_POWER_UP:
+            if (display->startupTicks > 0)
+                break;
+            for (uint8_t i = 0; i < display->numberOfDisplays; i++)
+                if (!I2CQueue_WriteBuffer(display->displayBus[i], display->displayAddress[i], &display->startupCommand, 1,
+                                          &display->startupInFlight[i], &display->linkError[i]))
+                    return; // Queue full, start over on the next tick
+            display->startupTicks = ALPHA_OSCILLATOR_TICKS;
+            display->startupState = ALPHA_STARTUP_OSCILLATOR;
+            break;
+        case ALPHA_STARTUP_OSCILLATOR:
+            if (display->startupTicks > 0)
+                break;
+            for (uint8_t i = 0; i < display->numberOfDisplays; i++)
+                if (display->startupInFlight[i])
+                    return;
+            setBrightness(display, 15);
+            display->startupState = ALPHA_STARTUP_DIMMING;
+            break;
+        case ALPHA_STARTUP_DIMMING:
+            if (!controlSettled(display, ALPHA_REG_DIMMING))
+                break;
+            display->displayOnOff = ALPHA_DISPLAY_ON; // Goes out with the blink rate in one write
+            setBlinkRate(display, ALPHA_BLINK_RATE_NOBLINK);
+            display->startupState = ALPHA_STARTUP_DISPLAY_SETUP;
+            break;
+        case ALPHA_STARTUP_DISPLAY_SETUP:
+            if (!controlSettled(display, ALPHA_REG_DISPLAY_SETUP))
+                break;
+            clear(display);
+            display->startupState = ALPHA_STARTUP_CLEAR;
+            break;
+        case ALPHA_STARTUP_CLEAR:
+            if (!frameSettled(display))
+                break;
+            display->startupState = ALPHA_STARTUP_READY;
+            if (display->startupReady != NULL)
+                display->startupReady(display);
+            break;
+        case ALPHA_STARTUP_READY:
+            break;
+    }
+}
+
+bool Alpha_IsReady(alpha_context_t *display) {
+    return display->startupState == ALPHA_STARTUP_READY;
+}
+
+bool Alpha_Begin(alpha_context_t *display, const i2c_host_interface_t *bus, uint8_t address) {
+    return Alpha_BeginChain(display, bus, &address, 1);
+}
+
+void Alpha_End(alpha_context_t *display) {
+    Alpha_ScrollStop(display);
+    Alpha_ScrubStop(display);
+    Alpha_KeyscanStop(display);
+    unbindContext(display);
+}
+// Set or clear the decimal on/off bit of one display
+
+bool setDecimalOnOffSingle(alpha_context_t *display, uint8_t displayNumber, bool turnOnDecimal, bool updateNow) {
+    uint8_t adr = 0x03 + displayNumber * 16;
     uint8_t dat;
 
     if (turnOnDecimal == true) {
-        decimalOnOff = ALPHA_DECIMAL_ON;
+        display->decimalOnOff[displayNumber] = ALPHA_DECIMAL_ON;
         dat = 0x01;
     } else {
-        decimalOnOff = ALPHA_DECIMAL_OFF;
+        display->decimalOnOff[displayNumber] = ALPHA_DECIMAL_OFF;
         dat = 0x00;
     }
 
-    displayRAM[adr] &= 0xFE;
-    displayRAM[adr] |= dat;
+    display->displayRAM[adr] &= 0xFE;
+    display->displayRAM[adr] |= dat;
+
+    if (updateNow) {
+        return updateDisplay(display);
+    } else {
+        return true;
+    }
+}
+// Set or clear the decimal on/off bit of every display
+
+bool setDecimalOnOff(alpha_context_t *display, bool turnOnDecimal, bool updateNow) {
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++)
+        setDecimalOnOffSingle(display, i, turnOnDecimal, false);
 
     if (updateNow) {
-        return updateDisplay();
+        return updateDisplay(display);
     } else {
         return true;
     }
 }
-// Set or clear the colon on/off bit
+// Set or clear the colon on/off bit of one display
 
-bool setColonOnOff(bool turnOnColon, bool updateNow) {
-    uint8_t adr = 0x01;
+bool setColonOnOffSingle(alpha_context_t *display, uint8_t displayNumber, bool turnOnColon, bool updateNow) {
+    uint8_t adr = 0x01 + displayNumber * 16;
     uint8_t dat;
 
     if (turnOnColon == true) {
-        colonOnOff = ALPHA_COLON_ON;
+        display->colonOnOff[displayNumber] = ALPHA_COLON_ON;
         dat = 0x01;
     } else {
-        colonOnOff = ALPHA_COLON_OFF;
+        display->colonOnOff[displayNumber] = ALPHA_COLON_OFF;
         dat = 0x00;
     }
 
-    displayRAM[adr] &= 0xFE;
-    displayRAM[adr] |= dat;
+    display->displayRAM[adr] &= 0xFE;
+    display->displayRAM[adr] |= dat;
+
+    if (updateNow) {
+        return updateDisplay(display);
+    } else {
+        return true;
+    }
+}
+// Set or clear the colon on/off bit of every display
+
+bool setColonOnOff(alpha_context_t *display, bool turnOnColon, bool updateNow) {
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++)
+        setColonOnOffSingle(display, i, turnOnColon, false);
 
     if (updateNow) {
-        return updateDisplay();
+        return updateDisplay(display);
     } else {
         return true;
     }
@@ -294,7 +1031,7 @@ uint16_t getSegmentsToTurnOn(uint16_t charPos) {
 }
 // Given a segment and a digit, set the matching bit within the RAM of the Holtek RAM set
 
-void illuminateSegment(uint8_t segment, uint8_t digit) {
+void illuminateSegment(alpha_context_t *display, uint8_t segment, uint8_t digit) {
     uint8_t com;
     uint8_t row;
 
@@ -311,8 +1048,8 @@ void illuminateSegment(uint8_t segment, uint8_t digit) {
     if (segment > 'G')
         row += 4;
 
-    //uint8_t offset = digit / 4 * 16;
-    uint8_t adr = com * 2; // + offset;
+    uint8_t offset = digit / 4 * 16;
+    uint8_t adr = com * 2 + offset;
 
     // Determine the address
     if (row > 7)
@@ -323,74 +1060,281 @@ void illuminateSegment(uint8_t segment, uint8_t digit) {
         row -= 8;
     uint8_t dat = (uint8_t) 1 << row;
 
-    displayRAM[adr] = displayRAM[adr] | dat;
+    display->displayRAM[adr] = display->displayRAM[adr] | dat;
 }
 // Given a binary set of segments and a digit, store this data into the RAM array
 
-void illuminateChar(uint16_t segmentsToTurnOn, uint8_t digit) {
+void illuminateChar(alpha_context_t *display, uint16_t segmentsToTurnOn, uint8_t digit) {
     for (uint8_t i = 0; i < 14; i++) // There are 14 segments on this display
     {
         if ((segmentsToTurnOn >> i) & 0b1)
-            illuminateSegment('A' + i, digit); // Convert the segment number to a letter
+            illuminateSegment(display, 'A' + i, digit); // Convert the segment number to a letter
     }
 }
-// Print a character, for a given digit, on display
+#if ALPHA_GLYPH_TABLE
+// OR one digit's 7 COM row masks into the RAM array
+
+void illuminateRows(alpha_context_t *display, const uint8_t *rows, uint8_t digit) {
+    uint8_t *ram = display->displayRAM + digit / 4 * 16;
+
+    ram[0] |= rows[0];
+    ram[2] |= rows[1];
+    ram[4] |= rows[2];
+    ram[6] |= rows[3];
+    ram[8] |= rows[4];
+    ram[10] |= rows[5];
+    ram[12] |= rows[6];
+}
+// Given a glyph index and a digit, OR its precomputed rows into the RAM array
 
-void printChar(uint8_t displayChar, uint8_t digit) {
-    // moved alphanumeric_segs array to PROGMEM Josh????
-    uint16_t characterPosition = 65532;
+void illuminateGlyph(alpha_context_t *display, uint16_t charPos, uint8_t digit) {
+    illuminateRows(display, alphanumeric_rows[digit & 0x03][charPos], digit);
+}
+#endif
+// Find a character's entry in alphanumeric_segs
 
+uint16_t getCharacterPosition(uint8_t displayChar) {
     // space
     if (displayChar == ' ' || displayChar == 0)
-        characterPosition = 0;
-        // Printable Symbols -- Between first character ! and last character ~
-    else if (displayChar >= '!' && displayChar <= '~') {
-        characterPosition = displayChar - '!' + 1;
+        return 0;
+    // Printable Symbols -- Between first character ! and last character ~
+    if (displayChar >= '!' && displayChar <= '~')
+        return displayChar - '!' + 1;
+    return SFE_ALPHANUM_UNKNOWN_CHAR;
+}
+// Light the segments of the character at characterPosition on a digit
+
+void renderCharacter(alpha_context_t *display, uint16_t characterPosition, uint8_t digit) {
+#if ALPHA_GLYPH_TABLE
+    illuminateGlyph(display, characterPosition, digit);
+#else
+    uint16_t segmentsToTurnOn = getSegmentsToTurnOn(characterPosition);
+
+    illuminateChar(display, segmentsToTurnOn, digit);
+#endif
+}
+// Store a custom character, reusing its slot if it is already defined
+
+bool defineChar(uint8_t displayChar, uint16_t segmentsToTurnOn) {
+    if (displayChar == 0 || displayChar >= ALPHA_CUSTOM_CHARS)
+        return false;
+
+    uint8_t slot = customGlyphSlot[displayChar];
+    if (slot == 0) {
+        while (slot < ALPHA_CUSTOM_GLYPHS && customGlyphChar[slot] != 0)
+            slot++;
+        if (slot == ALPHA_CUSTOM_GLYPHS)
+            return false; // Table full
+    } else {
+        slot--;
     }
 
+#if ALPHA_GLYPH_TABLE
+    // Same masks the compiler builds for alphanumeric_rows, so rendering costs the same
+    for (uint8_t digit = 0; digit < 4; digit++)
+        for (uint8_t com = 0; com < ALPHA_COM_COUNT; com++)
+            customGlyphRows[slot][digit][com] = ALPHA_ROW(segmentsToTurnOn, digit, com);
+#else
+    customGlyphSegs[slot] = segmentsToTurnOn;
+#endif
+    customGlyphChar[slot] = displayChar;
+    customGlyphSlot[displayChar] = slot + 1;
+    return true;
+}
+
+void undefineChar(uint8_t displayChar) {
+    if (displayChar == 0 || displayChar >= ALPHA_CUSTOM_CHARS || customGlyphSlot[displayChar] == 0)
+        return;
+
+    customGlyphChar[customGlyphSlot[displayChar] - 1] = 0;
+    customGlyphSlot[displayChar] = 0;
+}
+// Light displayChar's custom glyph on a digit; false if it has none
+
+bool illuminateCustom(alpha_context_t *display, uint8_t displayChar, uint8_t digit) {
+    if (displayChar >= ALPHA_CUSTOM_CHARS || customGlyphSlot[displayChar] == 0)
+        return false;
+
+    uint8_t slot = customGlyphSlot[displayChar] - 1;
+#if ALPHA_GLYPH_TABLE
+    illuminateRows(display, customGlyphRows[slot][digit & 0x03], digit);
+#else
+    illuminateChar(display, customGlyphSegs[slot], digit);
+#endif
+    return true;
+}
+// Print a character, for a given digit, on display
+
+void printChar(alpha_context_t *display, uint8_t displayChar, uint8_t digit) {
+    if (illuminateCustom(display, displayChar, digit))
+        return;
+
+    uint16_t characterPosition = getCharacterPosition(displayChar);
+
     // Take care of special characters by turning correct segment on
     if (characterPosition == 14) // '.'
-        setDecimalOnOff(true, false);
+        setDecimalOnOffSingle(display, digit / 4, true, false);
     if (characterPosition == 26) // ':'
-        setColonOnOff(true, false);
-    if (characterPosition == 65532) // unknown character
-        characterPosition = SFE_ALPHANUM_UNKNOWN_CHAR;
+        setColonOnOffSingle(display, digit / 4, true, false);
 
-    uint16_t segmentsToTurnOn = getSegmentsToTurnOn(characterPosition);
+    renderCharacter(display, characterPosition, digit);
+}
+// Move every rendered digit one place to the left; the leftmost one drops off.
+// Digit d is bit d (segments A-G) and bit d + 4 (segments H-N) of each COM
+// byte, so this is a shift within both nibbles plus a carry in from the next
+// display's digit 0. Decimal point and colon bits are not moved.
+
+void shiftDigitsLeft(alpha_context_t *display) {
+    for (uint8_t i = 0; i < display->numberOfDisplays; i++) {
+        uint8_t *ram = display->displayRAM + i * 16;
+        bool last = (i + 1 == display->numberOfDisplays);
+
+        for (uint8_t com = 0; com < 14; com += 2) {
+            uint8_t rows = (ram[com] >> 1) & 0x77;
+            if (!last)
+                rows |= (ram[com + 16] & 0x11) << 3; // Not yet shifted, display i + 1 comes next
+            ram[com] = rows;
+        }
+    }
+}
+// Start a marquee of length characters read round-robin from text, one new
+// character entering from the right every ticksPerStep calls of Alpha_ScrollTick().
+// text is not copied and must stay valid while scrolling.
+
+bool Alpha_ScrollStart(alpha_context_t *display, const char *text, size_t length, uint16_t ticksPerStep) {
+    if (text == NULL || length == 0 || ticksPerStep == 0)
+        return false;
+
+    display->scrollText = text;
+    display->scrollLength = length;
+    display->scrollNext = 0;
+    display->scrollTicksPerStep = ticksPerStep;
+    display->scrollCountdown = 1; // First character enters on the next tick
+    return clear(display);
+}
+
+void Alpha_ScrollStop(alpha_context_t *display) {
+    display->scrollText = NULL;
+}
+// Advance the marquee, run by Alpha_Tasks() once per display tick; a step
+// costs one RAM shift, one glyph render and a dirty-span update.
+
+bool Alpha_ScrollTick(alpha_context_t *display) {
+    if (display->scrollText == NULL || --display->scrollCountdown > 0)
+        return true;
+    display->scrollCountdown = display->scrollTicksPerStep;
+
+    uint8_t lastDigit = 4 * display->numberOfDisplays - 1;
+    uint8_t entering = (uint8_t) display->scrollText[display->scrollNext];
 
-    illuminateChar(segmentsToTurnOn, digit);
+    if (++display->scrollNext == display->scrollLength)
+        display->scrollNext = 0;
+
+    shiftDigitsLeft(display);
+    if (!illuminateCustom(display, entering, lastDigit))
+        renderCharacter(display, getCharacterPosition(entering), lastDigit);
+    return updateDisplay(display);
 }
 
 /*
  * Write a character buffer to the display.
  * Required for overloading the Print function.
  */
-size_t Alpha_Write(const char *buffer, size_t size) {
+size_t Alpha_Write(alpha_context_t *display, const char *buffer, size_t size) {
     char buff;
-    size = size > 4 ? 4 : size;
+    uint8_t digits = 4 * display->numberOfDisplays;
+
+    display->scrollText = NULL; // Writing replaces a running scroll
 
-    // Clear the displayRAM array
-    for (uint8_t i = 0; i < 16; i++)
-        displayRAM[i] = 0;
+    // Clear the display->displayRAM array
+    for (uint8_t i = 0; i < 16 * display->numberOfDisplays; i++)
+        display->displayRAM[i] = 0;
 
-    digitPosition = 0;
+    display->digitPosition = 0;
     size_t stringIndex = 0;
 
-    while (stringIndex < size && digitPosition < (4)) {
+    // The digit count bounds the loop, so '.' and ':' do not use up a digit
+    while (stringIndex < size && display->digitPosition < digits) {
         buff = buffer[stringIndex];
-        // For special characters like '.' or ':', do not increment the digitPosition
+        // For special characters like '.' or ':', do not increment the display->digitPosition.
+        // They light the segment on the display holding the previous character.
         if (buff == '.')
-            printChar('.', 0);
+            printChar(display, '.', display->digitPosition > 0 ? display->digitPosition - 1 : 0);
         else if (buff == ':')
-            printChar(':', 0);
+            printChar(display, ':', display->digitPosition > 0 ? display->digitPosition - 1 : 0);
         else {
-            printChar(buff, digitPosition);
-            displayContent[digitPosition] = buff; // Record to internal array
+            printChar(display, buff, display->digitPosition);
+            display->displayContent[display->digitPosition] = buff; // Record to internal array
 
-            digitPosition++;
+            display->digitPosition++;
         }
         stringIndex++;
     }
-    updateDisplay(); // Send RAM buffer over I2C bus
+    updateDisplay(display); // Send RAM buffer over I2C bus
     return stringIndex;
+}
+// Render a signed number right aligned across the chain without going through
+// sprintf. decimals digits go right of the decimal point, which each board has
+// between its second and third digit. Shows dashes and returns false if the
+// number does not fit.
+
+bool writeNumber(alpha_context_t *display, int32_t value, uint8_t decimals, bool leadingZeros) {
+    uint8_t digits = 4 * display->numberOfDisplays;
+    uint32_t magnitude = (value < 0) ? 0u - (uint32_t) value : (uint32_t) value;
+    uint8_t pointDigit = digits - decimals - 1; // Digit whose board lights the decimal point
+    uint8_t position = digits;
+    char *content = display->displayContent;
+
+    if (decimals > 0 && (decimals >= digits || pointDigit % 4 != 1))
+        return false;
+
+    display->scrollText = NULL; // Writing replaces a running scroll
+    for (uint8_t i = 0; i < 16 * display->numberOfDisplays; i++)
+        display->displayRAM[i] = 0;
+
+    // Least significant digit first, at least as far as the digit before the point
+    do {
+        uint8_t digit;
+
+        if (magnitude > 0xFFFF) {
+            digit = magnitude % 10;
+            magnitude /= 10;
+        } else {
+            uint16_t small = (uint16_t) magnitude; // 16 bit division is much cheaper on the PIC18
+            digit = small % 10;
+            magnitude = small / 10;
+        }
+        content[--position] = (char) ('0' + digit);
+    } while ((magnitude != 0 || (decimals > 0 && position > pointDigit)) && position > 0);
+
+    bool fits = (magnitude == 0) && !(value < 0 && position == 0);
+
+    if (!fits) {
+        memset(content, '-', digits);
+    } else {
+        if (value < 0 && !leadingZeros)
+            content[--position] = '-';
+        while (position > 0)
+            content[--position] = leadingZeros ? '0' : ' ';
+        if (value < 0 && leadingZeros)
+            content[0] = '-';
+        if (decimals > 0)
+            setDecimalOnOffSingle(display, pointDigit / 4, true, false);
+    }
+    content[digits] = '\0';
+    display->digitPosition = digits;
+
+    for (uint8_t i = 0; i < digits; i++)
+        printChar(display, content[i], i);
+    updateDisplay(display);
+    return fits;
+}
+
+bool Alpha_WriteInt(alpha_context_t *display, int32_t value, bool leadingZeros) {
+    return writeNumber(display, value, 0, leadingZeros);
+}
+// value is scaled by 10^decimals: Alpha_WriteFixed(display, 1234, 2, false) shows 12.34
+
+bool Alpha_WriteFixed(alpha_context_t *display, int32_t value, uint8_t decimals, bool leadingZeros) {
+    return writeNumber(display, value, decimals, leadingZeros);
 }
\ No newline at end of file
@@ -35,6 +35,47 @@ Distributed as-is; no warranty is given.
 //#include "/mcc_generated_files/timer/delay.h"
 
 #define DEFAULT_ADDRESS 0x70 
+// Addresses the ADR pins can select, searched when a display stops answering
+#define ALPHA_ADDRESS_FIRST 0x70
+#define ALPHA_ADDRESS_LAST 0x77
+// Displays that can be chained into one logical display, each with its own address
+#ifndef ALPHA_MAX_DISPLAYS
+#define ALPHA_MAX_DISPLAYS 4
+#endif
+// 1: render through the precomputed display RAM row table (fast, ~2.7 KB flash)
+// 0: render segment by segment through illuminateSegment()
+#ifndef ALPHA_GLYPH_TABLE
+#define ALPHA_GLYPH_TABLE 1
+#endif
+// Period of the tick that drives Alpha_StartupTick() and Alpha_ScrollTick(), in
+// milliseconds. Alpha_Tasks() calls both off the tick service as it elapses.
+#ifndef ALPHA_TICK_MS
+#define ALPHA_TICK_MS 1
+#endif
+// Ticks Alpha_Tasks() runs in one call to catch up with a late main loop.
+// Older ticks are dropped, which stretches timeouts rather than running a
+// burst of them after a long stall.
+#ifndef ALPHA_CATCH_UP_TICKS
+#define ALPHA_CATCH_UP_TICKS 32
+#endif
+// A display whose write fails is probed up to ALPHA_RETRY_LIMIT times, the
+// first ALPHA_RETRY_MS after the failure and twice as long after each miss
+#ifndef ALPHA_RETRY_LIMIT
+#define ALPHA_RETRY_LIMIT 5
+#endif
+#ifndef ALPHA_RETRY_MS
+#define ALPHA_RETRY_MS 10
+#endif
+// Bus the display is attached to. Build with -DALPHA_HOST_SIM to run the
+// library against the simulated HT16K33 in host/ instead of I2C1
+#ifdef ALPHA_HOST_SIM
+#include "host/ht16k33_sim.h"
+#define ALPHA_I2C_HOST HT16K33_Sim_Host
+#define ALPHA_I2C_DONE_REGISTER HT16K33_Sim_TransferDoneCallbackRegister
+#else
+#define ALPHA_I2C_HOST I2C1_Host
+#define ALPHA_I2C_DONE_REGISTER I2C1_Host_TransferDoneCallbackRegister
+#endif
 // Define constants for segment bits
 #define SEG_A 0x0001
 #define SEG_B 0x0002
@@ -77,19 +118,225 @@ typedef enum {
     ALPHA_CMD_SYSTEM_SETUP = 0b00100000,
     ALPHA_CMD_DISPLAY_SETUP = 0b10000000,
     ALPHA_CMD_DIMMING_SETUP = 0b11100000,
+    ALPHA_CMD_ROW_INT_SET = 0b10100000, // Bit 0: ROW15 pin is INT, bit 1: INT active high
 } alpha_command_t;
 
-// Structure for defining new character displays
+// Write-only HT16K33 registers shadowed by the context
+typedef enum {
+    ALPHA_REG_DIMMING,
+    ALPHA_REG_DISPLAY_SETUP,
+    ALPHA_CONTROL_REGISTERS
+} alpha_control_register_t;
+
+// Steps of the non-blocking bring up started by Alpha_BeginAsync()
+typedef enum {
+    ALPHA_STARTUP_POWER_UP, // Waiting for the drivers to power up
+    ALPHA_STARTUP_OSCILLATOR, // Oscillator on sent, waiting for it to start
+    ALPHA_STARTUP_DIMMING,
+    ALPHA_STARTUP_DISPLAY_SETUP,
+    ALPHA_STARTUP_CLEAR, // Blank frame on its way to every display
+    ALPHA_STARTUP_READY
+} alpha_startup_state_t;
 
-struct CharDef {
-    uint8_t position;
-    uint16_t segments; //this use to be int16_t
-    struct CharDef * next;
-};
+// Health of the bus link to one HT16K33, kept by Alpha_LinkTick()
+typedef enum {
+    ALPHA_LINK_UP,
+    ALPHA_LINK_BACKOFF, // A write failed, waiting to probe the address
+    ALPHA_LINK_PROBING, // Address-only write on its way
+    ALPHA_LINK_SCANNING, // Address NACKed, probing 0x70-0x77 for where the display went
+    ALPHA_LINK_VERIFYING, // Reading key data RAM at the address found, to check it is an HT16K33
+    ALPHA_LINK_DOWN // ALPHA_RETRY_LIMIT probes failed, see Alpha_Reconnect()
+} alpha_link_state_t;
 
-bool Alpha_Begin(void);
-size_t Alpha_Write(const char *, size_t);
+// Key press and release events buffered for Alpha_KeyEventGet(), a power of 2
+#ifndef ALPHA_KEY_EVENTS
+#define ALPHA_KEY_EVENTS 16
+#endif
+// Polls in a row a key change must be seen on before it is reported
+#ifndef ALPHA_KEY_DEBOUNCE
+#define ALPHA_KEY_DEBOUNCE 2
+#endif
+// Key matrix: K1-K3 against ROW0-ROW12, key number 13 * (K - 1) + row
+#define ALPHA_KEY_COLUMNS 3
+#define ALPHA_KEY_ROWS 13
 
+typedef struct {
+    uint8_t key; // 0 to ALPHA_KEY_COLUMNS * ALPHA_KEY_ROWS - 1
+    bool pressed; // false for a release
+} alpha_key_event_t;
 
-#endif	/* ALPHADISPLAY_H */
+// Custom characters that can be defined with defineChar() at one time
+#ifndef ALPHA_CUSTOM_GLYPHS
+#define ALPHA_CUSTOM_GLYPHS 8
+#endif
+
+// State of one logical display: a chain of 1 to ALPHA_MAX_DISPLAYS HT16K33s,
+// each on any bus. Allocate statically, one per logical display; no heap is used.
 
+typedef struct alpha_context {
+    uint8_t numberOfDisplays;
+    const i2c_host_interface_t *displayBus[ALPHA_MAX_DISPLAYS];
+    uint8_t displayAddress[ALPHA_MAX_DISPLAYS];
+    // 16 bytes of HT16K33 RAM per display, display N starts at N * 16
+    uint8_t displayRAM[16 * ALPHA_MAX_DISPLAYS];
+    uint8_t sentRAM[16 * ALPHA_MAX_DISPLAYS]; // Copy of each driver's display RAM as of the last frame put on the bus
+    bool sentRAMValid[ALPHA_MAX_DISPLAYS];
+    // Frames handed to the non-blocking I2C driver must outlive the call:
+    // the front frame is being transmitted, the back frame is next
+    uint8_t frameBuffer[ALPHA_MAX_DISPLAYS][2][17];
+    uint8_t frontFrame[ALPHA_MAX_DISPLAYS];
+    uint8_t backLength[ALPHA_MAX_DISPLAYS]; // Bytes waiting in the back frame, 0 when empty
+    volatile bool frameInFlight[ALPHA_MAX_DISPLAYS]; // Cleared by the queue once the front frame is sent
+    uint8_t digitPosition;
+    char displayContent[4 * ALPHA_MAX_DISPLAYS + 1];
+    uint8_t blinkRate; // Tracks blink bits in display setup register
+    bool displayOnOff;
+    // Shadows of the control registers: the command wanted, the last one put
+    // on the bus (0 until known), and the byte being sent to every display
+    uint8_t controlWanted[ALPHA_CONTROL_REGISTERS];
+    uint8_t controlSent[ALPHA_CONTROL_REGISTERS];
+    uint8_t controlCommand[ALPHA_CONTROL_REGISTERS];
+    volatile bool controlInFlight[ALPHA_CONTROL_REGISTERS][ALPHA_MAX_DISPLAYS];
+    bool decimalOnOff[ALPHA_MAX_DISPLAYS];
+    bool colonOnOff[ALPHA_MAX_DISPLAYS];
+    // Marquee, see Alpha_ScrollStart()
+    const char *scrollText; // NULL when not scrolling
+    size_t scrollLength;
+    size_t scrollNext; // Index of the next character to enter
+    uint16_t scrollTicksPerStep;
+    uint16_t scrollCountdown;
+    // Bring up, see Alpha_BeginAsync()
+    alpha_startup_state_t startupState;
+    uint16_t startupTicks; // Ticks left before the current step may finish
+    void (*startupReady)(struct alpha_context *display);
+    uint8_t startupCommand;
+    volatile bool startupInFlight[ALPHA_MAX_DISPLAYS];
+    uint32_t lastTick; // Tick_Get() as of the last display tick run by Alpha_Tasks()
+    // Link health, see Alpha_LinkTick(). Nothing but probes is sent to a
+    // display whose link is not up.
+    alpha_link_state_t linkState[ALPHA_MAX_DISPLAYS];
+    uint8_t linkRetries[ALPHA_MAX_DISPLAYS]; // Probes that failed since the link went down
+    uint16_t linkBackoff[ALPHA_MAX_DISPLAYS]; // Ticks left before the next probe
+    volatile i2c_host_error_t linkError[ALPHA_MAX_DISPLAYS]; // Latched by the queue when a write fails
+    volatile i2c_host_error_t probeError[ALPHA_MAX_DISPLAYS];
+    volatile bool probeInFlight[ALPHA_MAX_DISPLAYS];
+    uint8_t scanStep[ALPHA_MAX_DISPLAYS]; // 0: own address, 1-8: ALPHA_ADDRESS_FIRST + step - 1
+    uint8_t scanAddress[ALPHA_MAX_DISPLAYS]; // Address of the probe in flight
+    uint8_t verifyPointer; // Key data RAM address the identity read starts at
+    uint8_t verifyRAM[ALPHA_MAX_DISPLAYS][6]; // Key data RAM read back from an address found by a scan
+    // Read-back verification, see Alpha_ScrubStart()
+    uint16_t scrubTicksPerRead; // 0 when off
+    uint16_t scrubCountdown;
+    uint8_t scrubIndex; // Display read back next, or being read back
+    bool scrubReading;
+    bool scrubStale; // A frame was queued for the display while it was read
+    uint8_t scrubPointer; // Display RAM address the read starts at
+    uint8_t scrubRAM[16];
+    volatile bool scrubInFlight;
+    uint16_t scrubRepairs; // Read backs that did not match what was sent
+    // Keyscan, see Alpha_KeyscanStart()
+    uint16_t keyTicksPerPoll; // 0 when off
+    uint16_t keyCountdown;
+    uint8_t keyDisplay; // Display in the chain whose key matrix is read
+    bool keyReading;
+    bool keyInterrupt; // Poll only after Alpha_KeyInterrupt() and while keys are down
+    volatile bool keyWake; // Set by Alpha_KeyInterrupt()
+    uint8_t keyRowIntCommand;
+    uint8_t keyPointer; // Key data RAM address the read starts at
+    uint8_t keyRAM[2 * ALPHA_KEY_COLUMNS];
+    volatile bool keyInFlight;
+    uint16_t keyRaw[ALPHA_KEY_COLUMNS]; // Last poll
+    uint8_t keyAgreement; // Polls in a row that matched keyRaw
+    uint16_t keyState[ALPHA_KEY_COLUMNS]; // Debounced
+    // Single producer, single consumer ring: Alpha_KeyscanTick() only moves
+    // keyHead and Alpha_KeyEventGet() only moves keyTail
+    alpha_key_event_t keyEvents[ALPHA_KEY_EVENTS];
+    volatile uint8_t keyHead;
+    volatile uint8_t keyTail;
+    uint8_t keyOverflows; // Events dropped because the ring was full
+    struct alpha_context *next; // Every bound context is listed until Alpha_End(), see addressClaimed()
+} alpha_context_t;
+
+// Alpha_Begin() and Alpha_BeginChain() wait out the 20 ms power up and the
+// 10 ms oscillator start in DELAY_milliseconds(); only Alpha_BeginAsync() and
+// Alpha_BeginAsyncBuses() return at once.
+bool Alpha_Begin(alpha_context_t *display, const i2c_host_interface_t *bus, uint8_t address);
+// Drive count displays at addresses[0..count-1] as one display of 4 * count characters
+bool Alpha_BeginChain(alpha_context_t *display, const i2c_host_interface_t *bus, const uint8_t *addresses, uint8_t count);
+// Same as Alpha_BeginChain() without blocking: Alpha_StartupTick(), run every
+// ALPHA_TICK_MS by Alpha_Tasks(), sequences the bring up and calls ready (may
+// be NULL) once the displays are on and blank. Write to the display only after that.
+bool Alpha_BeginAsync(alpha_context_t *display, const i2c_host_interface_t *bus, const uint8_t *addresses, uint8_t count,
+        void (*ready)(alpha_context_t *display));
+// Same as Alpha_BeginAsync() with display N on buses[N], so a chain can be
+// split across buses. The queue drives every bus at once, so frames to
+// displays on different buses go out in parallel. Every driver must implement
+// Transfer(); register I2CQueue_TransferDone() with those other than
+// ALPHA_I2C_HOST if other code also uses their bus.
+bool Alpha_BeginAsyncBuses(alpha_context_t *display, const i2c_host_interface_t *const *buses, const uint8_t *addresses, uint8_t count,
+        void (*ready)(alpha_context_t *display));
+// Stop the scroll, scrub and key scan and forget the context, so a later
+// rescan may take over its addresses and the context may be reused or go out
+// of scope. Transfers already queued still report into it: keep it until
+// I2CQueue_Depth() is 0. Beginning a context again does not need this.
+void Alpha_End(alpha_context_t *display);
+void Alpha_StartupTick(alpha_context_t *display);
+bool Alpha_IsReady(alpha_context_t *display);
+// Run every ALPHA_TICK_MS by Alpha_Tasks(): notices failed writes, probes the
+// display with backoff and, once it answers, sends it its setup and frame again
+void Alpha_LinkTick(alpha_context_t *display);
+// Read one display's RAM back every ticksPerRead ticks of ALPHA_TICK_MS, in
+// turn, and rewrite what differs from the last frame sent. Bus cost is one
+// 16 byte read per period whatever the chain length.
+void Alpha_ScrubStart(alpha_context_t *display, uint16_t ticksPerRead);
+void Alpha_ScrubStop(alpha_context_t *display);
+void Alpha_ScrubTick(alpha_context_t *display);
+// Read the key matrix of one display in the chain every ticksPerPoll ticks
+// of ALPHA_TICK_MS and queue debounced press and release events
+bool Alpha_KeyscanStart(alpha_context_t *display, uint8_t displayNumber, uint16_t ticksPerPoll);
+// Same, but the driver's ROW15/INT pin is made an active low key interrupt:
+// key RAM is read only after Alpha_KeyInterrupt() and until every key is
+// released again, so an idle keypad costs no bus traffic. ROW15 is not used
+// by the alphanumeric segments.
+bool Alpha_KeyscanInterruptStart(alpha_context_t *display, uint8_t displayNumber, uint16_t ticksPerPoll);
+// Call from the external interrupt handler the INT pin is wired to
+void Alpha_KeyInterrupt(alpha_context_t *display);
+void Alpha_KeyscanStop(alpha_context_t *display);
+void Alpha_KeyscanTick(alpha_context_t *display);
+// Take the oldest key event; false when there is none
+bool Alpha_KeyEventGet(alpha_context_t *display, alpha_key_event_t *event);
+// True while every display in the chain acknowledges its writes
+bool isConnected(alpha_context_t *display);
+// Start probing displays that were given up on again
+void Alpha_Reconnect(alpha_context_t *display);
+size_t Alpha_Write(alpha_context_t *display, const char *, size_t);
+// Call from the main loop: runs the display ticks that have elapsed and sends
+// a display frame held back while the bus was busy
+void Alpha_Tasks(alpha_context_t *display);
+// Print a number without sprintf, right aligned, blank or zero padded. The
+// fixed point form lights the decimal point, so decimals must put it between
+// the second and third digit of a board (2, 6, 10 ... on a chain)
+bool Alpha_WriteInt(alpha_context_t *display, int32_t value, bool leadingZeros);
+bool Alpha_WriteFixed(alpha_context_t *display, int32_t value, uint8_t decimals, bool leadingZeros);
+// Scroll text of any length through the display, one step per ticksPerStep ticks
+// of ALPHA_TICK_MS
+bool Alpha_ScrollStart(alpha_context_t *display, const char *text, size_t length, uint16_t ticksPerStep);
+bool Alpha_ScrollTick(alpha_context_t *display);
+void Alpha_ScrollStop(alpha_context_t *display);
+
+bool clear(alpha_context_t *display);
+bool updateDisplay(alpha_context_t *display);
+bool setBrightness(alpha_context_t *display, uint8_t level);
+bool setBlinkRate(alpha_context_t *display, float rate);
+bool setDisplayOnOff(alpha_context_t *display, bool turnOnDisplay);
+bool setDecimalOnOff(alpha_context_t *display, bool turnOnDecimal, bool updateNow);
+bool setDecimalOnOffSingle(alpha_context_t *display, uint8_t displayNumber, bool turnOnDecimal, bool updateNow);
+bool setColonOnOff(alpha_context_t *display, bool turnOnColon, bool updateNow);
+bool setColonOnOffSingle(alpha_context_t *display, uint8_t displayNumber, bool turnOnColon, bool updateNow);
+// Draw displayChar (0x01 to 0x7F) as segmentsToTurnOn (bit 0 = A ... bit 13 = N)
+// on every display, overriding any built-in glyph
+bool defineChar(uint8_t displayChar, uint16_t segmentsToTurnOn);
+void undefineChar(uint8_t displayChar);
+
+
+#endif	/* ALPHADISPLAY_H */
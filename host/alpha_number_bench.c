@@ -0,0 +1,79 @@
+/**
+ * Alpha_WriteInt Benchmark
+ *
+ * @file alpha_number_bench.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Times Alpha_WriteInt() against sprintf() followed by Alpha_Write()
+ *        on the simulated bus. Checks first that both light the same
+ *        display RAM, across two chained displays, for values from
+ *        -1234567 to 99999999, and on one display for the -999 to 9999
+ *        that the timed loops cycle through.
+ *
+ *        Build and run: make -C host bench
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+#include "bench_clock.h"
+
+#define CALLS 20000L
+
+static alpha_context_t direct;
+static alpha_context_t printed;
+
+int main(void) {
+    static const uint8_t addresses[] = {0x70, 0x71};
+    char text[16];
+    unsigned mismatches = 0;
+    uint64_t start, directTime, printedTime;
+
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_Attach(0x70);
+    HT16K33_Sim_Attach(0x71);
+    if (!Alpha_BeginChain(&direct, &HT16K33_Sim_Host, addresses, 2) || !Alpha_BeginChain(&printed, &HT16K33_Sim_Host, addresses, 2)) {
+        printf("bring up failed\n");
+        return 1;
+    }
+    for (int32_t value = -1234567; value <= 99999999; value += 7777) {
+        Alpha_WriteInt(&direct, value, false);
+        snprintf(text, sizeof (text), "%8ld", (long) value);
+        Alpha_Write(&printed, text, 8);
+        mismatches += memcmp(direct.displayRAM, printed.displayRAM, 32) != 0;
+    }
+    if (mismatches != 0) {
+        printf("FAIL Alpha_WriteInt differs from Alpha_Write of \"%%8ld\" for %u values\n", mismatches);
+        return 1;
+    }
+
+    // Four digits, the counter of main.c, over -999 to 9999 so that every
+    // value fits and neither path has to show an overflow
+    Alpha_Begin(&direct, &HT16K33_Sim_Host, 0x70);
+    Alpha_Begin(&printed, &HT16K33_Sim_Host, 0x70);
+    for (long value = -999; value <= 9999; value++) {
+        Alpha_WriteInt(&direct, (int32_t) value, false);
+        sprintf(text, "%4ld", value);
+        Alpha_Write(&printed, text, 4);
+        mismatches += memcmp(direct.displayRAM, printed.displayRAM, 16) != 0;
+    }
+    if (mismatches != 0) {
+        printf("FAIL Alpha_WriteInt differs from Alpha_Write of \"%%4ld\" for %u values\n", mismatches);
+        return 1;
+    }
+    start = Bench_Now();
+    for (long i = 0; i < CALLS; i++)
+        Alpha_WriteInt(&direct, (int32_t) (i % 10999 - 999), false);
+    directTime = (Bench_Now() - start) / CALLS;
+    start = Bench_Now();
+    for (long i = 0; i < CALLS; i++) {
+        sprintf(text, "%4ld", i % 10999 - 999);
+        Alpha_Write(&printed, text, 4);
+    }
+    printedTime = (Bench_Now() - start) / CALLS;
+
+    printf("Alpha_WriteInt %llu, sprintf + Alpha_Write %llu %s per call\n", (unsigned long long) directTime,
+           (unsigned long long) printedTime, BENCH_UNIT);
+    return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ * Alpha_Write Benchmark
+ *
+ * @file alpha_write_bench.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Times Alpha_Write(), clear() and updateDisplay() on the simulated
+ *        bus, including the write of the changed display RAM. host/Makefile builds it twice: with the
+ *        precomputed row table (ALPHA_GLYPH_TABLE=1, the default) and with
+ *        the per-segment loop it replaced (ALPHA_GLYPH_TABLE=0). The table
+ *        build first checks that the table lights the same RAM bits as the
+ *        loop for every glyph on every digit.
+ *
+ *        Build and run: make -C host bench
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+#include "bench_clock.h"
+
+#define GLYPHS 96 // Space and the printable ASCII characters
+#define CALLS 100000UL
+
+// Rendering paths of alphaDisplay.c, compared glyph by glyph
+void illuminateChar(alpha_context_t *display, uint16_t segmentsToTurnOn, uint8_t digit);
+#if ALPHA_GLYPH_TABLE
+void illuminateGlyph(alpha_context_t *display, uint16_t charPos, uint8_t digit);
+#endif
+uint16_t getSegmentsToTurnOn(uint16_t charPos);
+
+static alpha_context_t display;
+
+int main(void) {
+    static const char *const texts[] = {"1234", "ABCD", "WXYZ", "8888"};
+    uint64_t start, elapsed;
+#if ALPHA_GLYPH_TABLE
+    uint8_t loopRAM[sizeof (display.displayRAM)];
+    unsigned mismatches = 0;
+
+    for (uint16_t glyph = 0; glyph < GLYPHS; glyph++) {
+        for (uint8_t digit = 0; digit < 4; digit++) {
+            memset(display.displayRAM, 0, sizeof (display.displayRAM));
+            illuminateChar(&display, getSegmentsToTurnOn(glyph), digit);
+            memcpy(loopRAM, display.displayRAM, sizeof (loopRAM));
+            memset(display.displayRAM, 0, sizeof (display.displayRAM));
+            illuminateGlyph(&display, glyph, digit);
+            mismatches += memcmp(loopRAM, display.displayRAM, sizeof (loopRAM)) != 0;
+        }
+    }
+    if (mismatches != 0) {
+        printf("FAIL row table differs from the segment loop for %u glyph/digit pairs\n", mismatches);
+        return 1;
+    }
+#endif
+
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_Attach(0x70);
+    if (!Alpha_Begin(&display, &HT16K33_Sim_Host, 0x70)) {
+        printf("bring up failed\n");
+        return 1;
+    }
+    start = Bench_Now();
+    for (unsigned long i = 0; i < CALLS; i++)
+        Alpha_Write(&display, texts[i & 3], 4);
+    printf("%s: %llu %s per Alpha_Write", ALPHA_GLYPH_TABLE ? "row table   " : "segment loop",
+           (unsigned long long) ((Bench_Now() - start) / CALLS), BENCH_UNIT);
+#if ALPHA_GLYPH_TABLE
+    printf(", %u glyphs x 4 digits match", GLYPHS);
+#endif
+    printf("\n");
+
+    // Each clear() blanks an "8888" that was written and sent outside the timing
+    elapsed = 0;
+    for (unsigned long i = 0; i < CALLS; i++) {
+        Alpha_Write(&display, "8888", 4);
+        start = Bench_Now();
+        clear(&display);
+        elapsed += Bench_Now() - start;
+    }
+    printf("%s: %llu %s per clear\n", ALPHA_GLYPH_TABLE ? "row table   " : "segment loop",
+           (unsigned long long) (elapsed / CALLS), BENCH_UNIT);
+
+    // Every byte flipped, then nothing changed since the last frame
+    start = Bench_Now();
+    for (unsigned long i = 0; i < CALLS; i++) {
+        memset(display.displayRAM, i & 1 ? 0x00 : 0xFF, 16);
+        updateDisplay(&display);
+    }
+    printf("%s: %llu %s per updateDisplay of a full frame", ALPHA_GLYPH_TABLE ? "row table   " : "segment loop",
+           (unsigned long long) ((Bench_Now() - start) / CALLS), BENCH_UNIT);
+    start = Bench_Now();
+    for (unsigned long i = 0; i < CALLS; i++)
+        updateDisplay(&display);
+    printf(", %llu unchanged\n", (unsigned long long) ((Bench_Now() - start) / CALLS));
+    return 0;
+}
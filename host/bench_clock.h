@@ -0,0 +1,38 @@
+/**
+ * Host Benchmark Clock Header File
+ *
+ * @file bench_clock.h
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Timestamps for the host benchmarks: TSC cycles on x86, where the
+ *        figures in the commit history were taken, and nanoseconds anywhere
+ *        else. Host figures only rank the code paths against each other;
+ *        they say nothing absolute about the PIC18.
+ */
+
+#ifndef BENCH_CLOCK_H
+#define BENCH_CLOCK_H
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "TSC cycles"
+
+static inline uint64_t Bench_Now(void) {
+    return __rdtsc();
+}
+#else
+#include <time.h>
+#define BENCH_UNIT "ns"
+
+static inline uint64_t Bench_Now(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+#endif
+
+#endif /* BENCH_CLOCK_H */
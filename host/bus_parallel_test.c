@@ -0,0 +1,108 @@
+/**
+ * Parallel Bus Test
+ *
+ * @file bus_parallel_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Sends the same frames to a chain of four displays on one simulated
+ *        bus and split two and two across HT16K33_Sim_Host and
+ *        HT16K33_Sim_Host2. Right after each frame is written both buses
+ *        must have a transfer in flight, and the split chain must take
+ *        little more than half the bus time. The line it prints compares the
+ *        two.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+#include "i2cQueue.h"
+#include "tick.h"
+
+#define DISPLAYS 4
+#define FRAMES 100
+
+static alpha_context_t display;
+static int failures;
+static const uint8_t addresses[DISPLAYS] = {0x70, 0x71, 0x72, 0x73};
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void pump(void) {
+    HT16K33_Sim_Host.Tasks();
+    HT16K33_Sim_Host2.Tasks();
+    Alpha_Tasks(&display);
+}
+
+// Every display's RAM on its bus matches its part of the context RAM
+static bool showing(const i2c_host_interface_t *const *buses) {
+    for (uint8_t i = 0; i < DISPLAYS; i++) {
+        HT16K33_Sim_BusSelect(buses[i] == &HT16K33_Sim_Host2 ? 1 : 0);
+        if (memcmp(HT16K33_Sim_DeviceGet(addresses[i])->displayRAM, &display.displayRAM[i * 16], 16) != 0)
+            return false;
+    }
+    HT16K33_Sim_BusSelect(0);
+    return true;
+}
+
+// Microseconds of simulated time FRAMES full frames take; rounds counts the
+// frames after which both buses had a transfer in flight at once
+static uint64_t frames(const i2c_host_interface_t *const *buses, uint16_t *rounds) {
+    char text[4 * DISPLAYS];
+    uint64_t start;
+
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_AsyncSet(true);
+    for (uint8_t i = 0; i < DISPLAYS; i++) {
+        HT16K33_Sim_BusSelect(buses[i] == &HT16K33_Sim_Host2 ? 1 : 0);
+        HT16K33_Sim_Attach(addresses[i]);
+    }
+    HT16K33_Sim_BusSelect(0);
+    TMR0_Initialize();
+    Tick_Initialize();
+    Alpha_BeginAsyncBuses(&display, buses, addresses, DISPLAYS, NULL);
+    for (uint16_t t = 0; t < 60 && !Alpha_IsReady(&display); t++) {
+        TMR0_Host_Advance(1);
+        pump();
+    }
+    expect(Alpha_IsReady(&display), "bring up");
+
+    *rounds = 0;
+    start = HT16K33_Sim_TimeGet();
+    for (uint16_t f = 0; f < FRAMES; f++) {
+        for (uint8_t c = 0; c < sizeof (text); c++)
+            text[c] = (char) ('A' + (f + c) % 26);
+        Alpha_Write(&display, text, sizeof (text));
+        if (HT16K33_Sim_Host.IsBusy() && HT16K33_Sim_Host2.IsBusy())
+            (*rounds)++;
+        while (I2CQueue_Depth() > 0 || HT16K33_Sim_Host.IsBusy() || HT16K33_Sim_Host2.IsBusy())
+            pump();
+    }
+    expect(showing(buses), "every display shows the last frame");
+    return HT16K33_Sim_TimeGet() - start;
+}
+
+int main(void) {
+    const i2c_host_interface_t *oneBus[DISPLAYS] = {&HT16K33_Sim_Host, &HT16K33_Sim_Host, &HT16K33_Sim_Host, &HT16K33_Sim_Host};
+    const i2c_host_interface_t *split[DISPLAYS] = {&HT16K33_Sim_Host, &HT16K33_Sim_Host, &HT16K33_Sim_Host2, &HT16K33_Sim_Host2};
+    uint16_t oneBusRounds, splitRounds;
+    uint64_t oneBusTime = frames(oneBus, &oneBusRounds);
+    uint64_t splitTime = frames(split, &splitRounds);
+
+    printf("%u displays, %u frames at %lu Hz: one bus %llu us, split 2+2 %llu us (%.2fx), both buses busy after %u of %u frames\n",
+           DISPLAYS, FRAMES, HT16K33_SIM_DEFAULT_CLOCK, (unsigned long long) oneBusTime, (unsigned long long) splitTime,
+           (double) oneBusTime / (double) splitTime, splitRounds, FRAMES);
+    expect(oneBusRounds == 0, "one bus: second bus never used");
+    expect(splitRounds == FRAMES, "split: both buses busy at once after every frame");
+    expect(splitTime * 10 < oneBusTime * 6, "split: under 60% of the one bus time");
+
+    printf("parallel buses: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * Context End Test
+ *
+ * @file context_end_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Ends a context with Alpha_End(), overwrites it the way a stack frame
+ *        that went out of scope would be, and checks that the link rescan of
+ *        another display neither reads it nor keeps treating its address as
+ *        taken. Also checks that a context begun twice is listed only once.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+#include "i2cQueue.h"
+#include "tick.h"
+
+#define RUN_TICKS 400
+
+static alpha_context_t first;
+static alpha_context_t second;
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+// Ticks the contexts still in use, NULL for none
+static void run(uint16_t ticks, alpha_context_t *a, alpha_context_t *b) {
+    while (ticks-- > 0) {
+        TMR0_Host_Advance(1);
+        HT16K33_Sim_Host.Tasks();
+        if (a != NULL)
+            Alpha_Tasks(a);
+        if (b != NULL)
+            Alpha_Tasks(b);
+    }
+}
+
+static void begin(alpha_context_t *display, uint8_t address) {
+    HT16K33_Sim_Attach(address);
+    Alpha_BeginAsync(display, &HT16K33_Sim_Host, &address, 1, NULL);
+}
+
+static void reset(void) {
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_AsyncSet(true);
+    TMR0_Initialize();
+    Tick_Initialize();
+}
+
+// Display RAM of the simulated device at address matches the frame of display
+static bool showing(const alpha_context_t *display, uint16_t address) {
+    const ht16k33_sim_device_t *dev = HT16K33_Sim_DeviceGet(address);
+
+    return dev->attached && memcmp(dev->displayRAM, display->displayRAM, sizeof (dev->displayRAM)) == 0;
+}
+
+int main(void) {
+    // The second display is ended and its context reused; the first moves to its address
+    reset();
+    begin(&first, 0x70);
+    begin(&second, 0x71);
+    run(60, &first, &second);
+    expect(Alpha_IsReady(&first) && Alpha_IsReady(&second), "ended: bring up");
+    Alpha_End(&second);
+    run(1, &first, NULL);
+    expect(I2CQueue_Depth() == 0, "ended: nothing queued for the ended context");
+    memset(&second, 0xA5, sizeof (second));
+    HT16K33_Sim_Detach(0x71);
+    HT16K33_Sim_Move(0x70, 0x71);
+    Alpha_Write(&first, "FREE", 4);
+    run(RUN_TICKS, &first, NULL);
+    expect(first.linkState[0] == ALPHA_LINK_UP && first.displayAddress[0] == 0x71, "ended: address taken over");
+    expect(showing(&first, 0x71), "ended: frame replayed there");
+
+    // The first context is begun twice, then ended once
+    reset();
+    begin(&first, 0x70);
+    begin(&first, 0x70);
+    begin(&second, 0x72);
+    run(60, &first, &second);
+    expect(Alpha_IsReady(&first) && Alpha_IsReady(&second), "begun twice: bring up");
+    Alpha_End(&first);
+    memset(&first, 0xA5, sizeof (first));
+    HT16K33_Sim_Detach(0x70);
+    HT16K33_Sim_Move(0x72, 0x70);
+    Alpha_Write(&second, "ONCE", 4);
+    run(RUN_TICKS, NULL, &second);
+    expect(second.linkState[0] == ALPHA_LINK_UP && second.displayAddress[0] == 0x70, "begun twice: address taken over");
+    expect(showing(&second, 0x70), "begun twice: frame replayed there");
+
+    printf("context end: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
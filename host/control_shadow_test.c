@@ -0,0 +1,75 @@
+/**
+ * Control Register Shadow Test
+ *
+ * @file control_shadow_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Calls setBrightness(), setBlinkRate() and setDisplayOnOff() over and
+ *        over with the same value and checks that each HT16K33 of a chain is
+ *        sent a dimming or display setup command only when the value
+ *        actually changes.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include "alphaDisplay.h"
+
+#define REPEATS 10
+
+static const uint8_t addresses[] = {0x70, 0x71};
+static alpha_context_t display;
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+// Every display of the chain decoded dimming and display setup writes as counted
+static bool writes(uint32_t dimming, uint32_t displaySetup) {
+    for (uint8_t i = 0; i < sizeof (addresses); i++) {
+        const ht16k33_sim_device_t *dev = HT16K33_Sim_DeviceGet(addresses[i]);
+
+        if (dev->dimmingWrites != dimming || dev->displaySetupWrites != displaySetup)
+            return false;
+    }
+    return true;
+}
+
+int main(void) {
+    HT16K33_Sim_Reset();
+    for (uint8_t i = 0; i < sizeof (addresses); i++)
+        HT16K33_Sim_Attach(addresses[i]);
+    expect(Alpha_BeginChain(&display, &HT16K33_Sim_Host, addresses, sizeof (addresses)), "bring up");
+    HT16K33_Sim_StatsClear();
+
+    for (uint8_t r = 0; r < REPEATS; r++)
+        setBrightness(&display, 7);
+    expect(writes(1, 0), "brightness: one dimming write for ten identical calls");
+    for (uint8_t r = 0; r < REPEATS; r++)
+        setBrightness(&display, 12);
+    expect(writes(2, 0), "brightness: one more for a new level");
+    expect(HT16K33_Sim_DeviceGet(addresses[1])->dimming == 12, "brightness: level reached the device");
+
+    for (uint8_t r = 0; r < REPEATS; r++)
+        setBlinkRate(&display, 2.0);
+    expect(writes(2, 1), "blink: one display setup write for ten identical calls");
+    for (uint8_t r = 0; r < REPEATS; r++)
+        setBlinkRate(&display, 0.5);
+    expect(writes(2, 2), "blink: one more for a new rate");
+
+    for (uint8_t r = 0; r < REPEATS; r++)
+        setDisplayOnOff(&display, true);
+    expect(writes(2, 2), "on: already on, nothing sent");
+    for (uint8_t r = 0; r < REPEATS; r++)
+        setDisplayOnOff(&display, false);
+    expect(writes(2, 3), "off: one display setup write");
+    expect(!HT16K33_Sim_DeviceGet(addresses[0])->displayOn, "off: reached the device");
+
+    printf("control shadow: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * Custom Glyph Test
+ *
+ * @file custom_glyph_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Defines characters with defineChar() and checks the display RAM
+ *        they render to against the HT16K33 segment wiring, worked out here
+ *        segment by segment as the original illuminateSegment() did. Also
+ *        covers overriding and restoring a built-in glyph, redefining a
+ *        character in place, and a full table. host/Makefile builds it for
+ *        both settings of ALPHA_GLYPH_TABLE.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+
+#define ADDRESS 0x70
+#define SEGMENTS 14
+
+static alpha_context_t display;
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+// Display RAM of one display lighting segments (bit 0 = A ... bit 13 = N) on digit
+static void wired(uint16_t segments, uint8_t digit, uint8_t *ram) {
+    for (uint8_t s = 0; s < SEGMENTS; s++) {
+        uint8_t com = s < 7 ? s : s - 7; // A-G and J-N share COM0-COM6 in order
+        uint8_t row = digit + (s < 7 ? 0 : 4);
+
+        if (!(segments & (1U << s)))
+            continue;
+        if (s == 7) // H
+            com = 1;
+        if (s == 8) // I
+            com = 0;
+        ram[com * 2] |= (uint8_t) (1U << row);
+    }
+}
+
+// The context and the driver hold segments on digit and nothing else
+static bool showing(uint16_t segments, uint8_t digit) {
+    uint8_t ram[16] = {0};
+
+    wired(segments, digit, ram);
+    return memcmp(display.displayRAM, ram, 16) == 0 && memcmp(HT16K33_Sim_DeviceGet(ADDRESS)->displayRAM, ram, 16) == 0;
+}
+
+int main(void) {
+    const uint16_t arrow = 0x2741; // A, G, I, J, K, N
+    const uint16_t box = 0x003F; // A-F
+    uint8_t builtin[16];
+    bool everyDigit = true;
+    bool everySegment = true;
+    char text[4];
+
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_Attach(ADDRESS);
+    expect(Alpha_Begin(&display, &HT16K33_Sim_Host, ADDRESS), "bring up");
+
+    // Rendering on every digit and of every single segment
+    expect(defineChar(0x01, arrow), "define 0x01");
+    for (uint8_t digit = 0; digit < 4; digit++) {
+        memset(text, ' ', sizeof (text));
+        text[digit] = 0x01;
+        Alpha_Write(&display, text, sizeof (text));
+        everyDigit &= showing(arrow, digit);
+    }
+    expect(everyDigit, "custom glyph wired on every digit");
+    for (uint8_t s = 0; s < SEGMENTS; s++) {
+        defineChar(0x01, (uint16_t) (1U << s));
+        Alpha_Write(&display, "\x01", 1);
+        everySegment &= showing((uint16_t) (1U << s), 0);
+    }
+    expect(everySegment, "every segment wired");
+
+    // Overriding a built-in glyph and restoring it
+    Alpha_Write(&display, "A", 1);
+    memcpy(builtin, display.displayRAM, sizeof (builtin));
+    expect(defineChar('A', box), "define 'A'");
+    Alpha_Write(&display, "A", 1);
+    expect(showing(box, 0), "'A' overridden");
+    undefineChar('A');
+    Alpha_Write(&display, "A", 1);
+    expect(memcmp(display.displayRAM, builtin, 16) == 0, "'A' built-in again after undefineChar()");
+
+    // Slots: redefining reuses one, the table fills up, undefining frees one
+    undefineChar(0x01);
+    for (uint8_t c = 0; c < ALPHA_CUSTOM_GLYPHS; c++)
+        expect(defineChar((uint8_t) (0x10 + c), box), "fill the table");
+    expect(defineChar(0x10, arrow), "redefine in place with the table full");
+    expect(!defineChar(0x7F, arrow), "table full: refused");
+    undefineChar(0x11);
+    expect(defineChar(0x7F, arrow), "freed slot reused");
+    Alpha_Write(&display, "\x10", 1);
+    expect(showing(arrow, 0), "redefined glyph shown");
+
+    expect(!defineChar(0x00, arrow) && !defineChar(0x80, arrow), "out of range refused");
+
+    printf("custom glyphs (%s): %s\n", ALPHA_GLYPH_TABLE ? "row table" : "segment loop", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
@@ -0,0 +1,24 @@
+/**
+ * DELAY Host Driver File
+ *
+ * @file delay_host.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Host replacement for mcc_generated_files/timer/src/delay.c. Delays
+ *        return immediately and advance the simulator clock instead, so
+ *        benchmarks are not dominated by wall-clock sleeps. Millisecond
+ *        delays go through the fake TMR0 so the tick keeps counting, as it
+ *        does on the target.
+ */
+
+#include "../mcc_generated_files/timer/delay.h"
+#include "ht16k33_sim.h"
+
+void DELAY_milliseconds(uint16_t milliseconds) {
+    TMR0_Host_Advance(milliseconds);
+}
+
+void DELAY_microseconds(uint16_t microseconds) {
+    HT16K33_Sim_TimeAdvance(microseconds);
+}
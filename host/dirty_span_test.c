@@ -0,0 +1,96 @@
+/**
+ * Dirty Span Test
+ *
+ * @file dirty_span_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Rewrites the text of a chain of two displays one digit at a time
+ *        and checks that each HT16K33 receives exactly the span of RAM
+ *        bytes between the first and last one that changed, nothing when
+ *        nothing changed, and ends up holding the context's RAM.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+
+static const uint8_t addresses[] = {0x70, 0x71};
+static alpha_context_t display;
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+// Bytes from the first to the last that differ, 0 if none do
+static uint8_t span(const uint8_t *before, const uint8_t *after) {
+    int8_t first = -1, last = -1;
+
+    for (int8_t i = 0; i < 16; i++)
+        if (before[i] != after[i]) {
+            if (first < 0)
+                first = i;
+            last = i;
+        }
+    return first < 0 ? 0 : (uint8_t) (last - first + 1);
+}
+
+static uint8_t before[sizeof (addresses)][16];
+
+static void snapshot(void) {
+    for (uint8_t i = 0; i < sizeof (addresses); i++)
+        memcpy(before[i], HT16K33_Sim_DeviceGet(addresses[i])->displayRAM, 16);
+    HT16K33_Sim_StatsClear();
+}
+
+// Check what each display was sent since snapshot()
+static void sent(const char *what) {
+    char label[80];
+
+    for (uint8_t i = 0; i < sizeof (addresses); i++) {
+        const ht16k33_sim_device_t *dev = HT16K33_Sim_DeviceGet(addresses[i]);
+        uint8_t expected = span(before[i], &display.displayRAM[16 * i]);
+
+        snprintf(label, sizeof (label), "%s: display %u sent the dirty span of %u bytes", what, i, expected);
+        expect(dev->ramBytesWritten == expected && dev->ramWrites == (expected != 0), label);
+        snprintf(label, sizeof (label), "%s: display %u RAM matches the context", what, i);
+        expect(memcmp(dev->displayRAM, &display.displayRAM[16 * i], 16) == 0, label);
+    }
+}
+
+static void write(const char *text, const char *what) {
+    snapshot();
+    Alpha_Write(&display, text, strlen(text));
+    sent(what);
+}
+
+int main(void) {
+    HT16K33_Sim_Reset();
+    for (uint8_t i = 0; i < sizeof (addresses); i++)
+        HT16K33_Sim_Attach(addresses[i]);
+    expect(Alpha_BeginChain(&display, &HT16K33_Sim_Host, addresses, sizeof (addresses)), "bring up");
+
+    write("ABCDEFGH", "first frame");
+    write("ABCDEFGH", "same text");
+    write("ABXDEFGH", "one digit on display 0");
+    write("ABXDEFGZ", "one digit on display 1");
+    write("QBXDEFGZ", "first digit");
+    write("QBXZEFGZ", "last digit of display 0");
+    write("1BX2EFGZ", "two digits");
+    expect(HT16K33_Sim_StatsGet()->transactions == 1, "two digits: one transaction");
+
+    // Glyphs spread over most of a display's RAM; the decimal point is one bit
+    snapshot();
+    setDecimalOnOffSingle(&display, 1, true, true);
+    sent("decimal point");
+    expect(HT16K33_Sim_DeviceGet(addresses[1])->ramBytesWritten == 1, "decimal point: one byte");
+
+    printf("dirty span: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * Display Chain Test
+ *
+ * @file display_chain_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Drives four HT16K33s as one 16 character display and checks that
+ *        every driver shows its own four characters, rendered as a lone
+ *        display would show them, that per display and chain-wide settings
+ *        reach the right drivers, and that a fifth display is refused.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+
+#define DISPLAYS 4
+#define REFERENCE 0x77
+
+static const uint8_t addresses[DISPLAYS + 1] = {0x70, 0x71, 0x72, 0x73, 0x74};
+static alpha_context_t display;
+static alpha_context_t reference; // One display, for the expected rendering
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+// Display i of the chain, in the context and on its driver, shows four characters
+static bool showing(uint8_t i, const char *characters) {
+    Alpha_Write(&reference, characters, 4);
+    return memcmp(&display.displayRAM[16 * i], reference.displayRAM, 16) == 0 &&
+            memcmp(HT16K33_Sim_DeviceGet(addresses[i])->displayRAM, reference.displayRAM, 16) == 0;
+}
+
+int main(void) {
+    static const char text[] = "ABCDEFGHIJKLMNOP";
+    bool split = true;
+
+    HT16K33_Sim_Reset();
+    for (uint8_t i = 0; i < DISPLAYS + 1; i++)
+        HT16K33_Sim_Attach(addresses[i]);
+    HT16K33_Sim_Attach(REFERENCE);
+    expect(!Alpha_BeginChain(&display, &HT16K33_Sim_Host, addresses, DISPLAYS + 1), "fifth display refused");
+    expect(Alpha_BeginChain(&display, &HT16K33_Sim_Host, addresses, DISPLAYS), "four displays accepted");
+    expect(Alpha_Begin(&reference, &HT16K33_Sim_Host, REFERENCE), "reference display");
+
+    Alpha_Write(&display, text, sizeof (text) - 1);
+    for (uint8_t i = 0; i < DISPLAYS; i++)
+        split &= showing(i, &text[4 * i]);
+    expect(split, "text: four characters per display, in chain order");
+    expect(strcmp(display.displayContent, text) == 0, "text: content holds all 16");
+    expect(HT16K33_Sim_DeviceGet(addresses[DISPLAYS])->ramWrites == 0, "text: fifth driver never written");
+
+    Alpha_Write(&display, "SHORT", 5);
+    expect(showing(0, "SHOR") && showing(1, "T   ") && showing(2, "    ") && showing(3, "    "), "short text: rest blank");
+
+    Alpha_WriteInt(&display, 42, false);
+    expect(showing(2, "    ") && showing(3, "  42"), "number: right aligned on the last display");
+
+    HT16K33_Sim_StatsClear();
+    setColonOnOffSingle(&display, 2, true, true);
+    for (uint8_t i = 0; i < DISPLAYS; i++)
+        expect(HT16K33_Sim_DeviceGet(addresses[i])->ramWrites == (i == 2), "colon: only display 2 written");
+
+    setBrightness(&display, 3);
+    for (uint8_t i = 0; i < DISPLAYS; i++)
+        expect(HT16K33_Sim_DeviceGet(addresses[i])->dimming == 3, "brightness: every display");
+    expect(HT16K33_Sim_DeviceGet(addresses[DISPLAYS])->dimmingWrites == 0, "brightness: not the fifth driver");
+
+    printf("display chain: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * Double Buffered Frame Test
+ *
+ * @file double_buffer_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Writes frames faster than the asynchronous simulated bus sends them.
+ *        The sim reads a transfer's buffer only when it completes, as the
+ *        I2C1 interrupts do, so the frame in flight must stay untouched
+ *        while newer frames replace each other in the back buffer. Once the
+ *        bus is free, Alpha_Tasks() sends only the newest of them.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+#include "tick.h"
+
+#define ADDRESS 0x70
+
+static alpha_context_t display;
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void run(uint16_t ticks) {
+    while (ticks-- > 0) {
+        TMR0_Host_Advance(1);
+        HT16K33_Sim_Host.Tasks();
+        Alpha_Tasks(&display);
+    }
+}
+
+int main(void) {
+    const uint8_t address = ADDRESS;
+    ht16k33_sim_device_t *dev;
+    uint8_t first[16], last[16];
+
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_AsyncSet(true);
+    HT16K33_Sim_Attach(ADDRESS);
+    dev = HT16K33_Sim_DeviceGet(ADDRESS);
+    TMR0_Initialize();
+    Tick_Initialize();
+    Alpha_BeginAsync(&display, &HT16K33_Sim_Host, &address, 1, NULL);
+    run(60);
+    expect(Alpha_IsReady(&display), "bring up");
+    HT16K33_Sim_StatsClear();
+
+    Alpha_Write(&display, "1111", 4);
+    memcpy(first, display.displayRAM, sizeof (first));
+    expect(HT16K33_Sim_Host.IsBusy() && display.frameInFlight[0], "first frame in flight");
+
+    // Newer frames while the first is still on the bus
+    Alpha_Write(&display, "2222", 4);
+    Alpha_Write(&display, "3333", 4);
+    Alpha_Write(&display, "4444", 4);
+    memcpy(last, display.displayRAM, sizeof (last));
+    expect(HT16K33_Sim_StatsGet()->transactions == 0, "back frames held while the bus is busy");
+    expect(display.backLength[0] != 0, "newest frame waiting in the back buffer");
+
+    // The first frame completes from the buffer it was handed over in
+    HT16K33_Sim_Host.Tasks();
+    expect(dev->ramWrites == 1 && memcmp(dev->displayRAM, first, 16) == 0, "front frame sent unchanged by later writes");
+
+    // Only the newest back frame follows
+    Alpha_Tasks(&display);
+    HT16K33_Sim_Host.Tasks();
+    expect(dev->ramWrites == 2 && memcmp(dev->displayRAM, last, 16) == 0, "back frame replaced by newer writes, sent once");
+    run(10);
+    expect(dev->ramWrites == 2 && display.backLength[0] == 0, "nothing more to send");
+
+    printf("double buffer: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
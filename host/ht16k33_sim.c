@@ -0,0 +1,423 @@
+/**
+ * HT16K33 Host Simulator Source File
+ *
+ * @file ht16k33_sim.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Decodes the HT16K33 command set from raw I2C transfers and keeps
+ *        bus level statistics. By default transfers complete synchronously.
+ *        In asynchronous mode a transfer stays in flight, and its buffers
+ *        are only read, until HT16K33_Sim_Host.Tasks() completes it, the
+ *        same way the I2C1 interrupts consume the caller's buffer late.
+ *        HT16K33_SIM_BUSES independent buses are modelled, each with its
+ *        own devices, counters and transfer done callback.
+ */
+
+#include <string.h>
+#include "ht16k33_sim.h"
+
+#define HT16K33_CMD_RAM_MASK 0xF0
+#define HT16K33_CMD_RAM 0x00
+#define HT16K33_CMD_KEY_RAM 0x40
+#define HT16K33_KEY_RAM_SIZE 6
+#define HT16K33_CMD_SYSTEM_SETUP 0x20
+#define HT16K33_CMD_DISPLAY_SETUP 0x80
+#define HT16K33_CMD_DIMMING 0xE0
+#define HT16K33_CMD_ROW_INT 0xA0
+
+/* Bits per byte on the wire: 8 data + ACK */
+#define I2C_BITS_PER_BYTE 9
+/* Start and Stop conditions, counted as one bit time each */
+#define I2C_FRAMING_BITS 2
+
+typedef struct {
+    bool busy;
+    uint16_t address;
+    uint8_t *writePtr;
+    size_t writeLength;
+    uint8_t *readPtr;
+    size_t readLength;
+    bool switchToRead;
+    i2c_host_transfer_callback_t callback;
+    void *context;
+} sim_transfer_t;
+
+typedef struct {
+    ht16k33_sim_device_t devices[HT16K33_SIM_MAX_DEVICES];
+    ht16k33_sim_stats_t stats;
+    uint32_t busClock;
+    i2c_host_error_t errorState;
+    void (*errorCallback)(void);
+    void (*transferDoneCallback)(void);
+    sim_transfer_t transfer;
+    uint64_t freeNs; // Simulated time the bus's last transaction ends
+} sim_bus_t;
+
+static sim_bus_t buses[HT16K33_SIM_BUSES];
+static sim_bus_t *selected = &buses[0]; // Bus the host-side functions below act on
+static uint64_t simTimeNs = 0; // Time the host has reached, not counting traffic
+static bool asyncMode = false;
+
+static ht16k33_sim_device_t *deviceLookup(sim_bus_t *bus, uint16_t address) {
+    if (address < HT16K33_SIM_BASE_ADDRESS || address >= HT16K33_SIM_BASE_ADDRESS + HT16K33_SIM_MAX_DEVICES)
+        return NULL;
+    return &bus->devices[address - HT16K33_SIM_BASE_ADDRESS];
+}
+
+static void deviceReset(ht16k33_sim_device_t *dev) {
+    bool attached = dev->attached;
+    memset(dev, 0, sizeof (*dev));
+    dev->attached = attached;
+}
+
+// Latest of the host's time and the end of every bus's last transaction
+
+static uint64_t timeNow(void) {
+    uint64_t now = simTimeNs;
+
+    for (uint8_t i = 0; i < HT16K33_SIM_BUSES; i++)
+        if (buses[i].freeNs > now)
+            now = buses[i].freeNs;
+    return now;
+}
+
+// Charge the bus for one Start..Stop sequence moving byteCount bytes after the
+// address byte. Each bus keeps its own clock: the transaction starts once the
+// host has asked for it and the bus's previous one has ended, so transactions
+// on different buses overlap.
+
+static void busCharge(sim_bus_t *bus, size_t byteCount) {
+    uint32_t bits = (uint32_t) (byteCount + 1) * I2C_BITS_PER_BYTE + I2C_FRAMING_BITS;
+    uint64_t ns = (uint64_t) bits * 1000000000ULL / bus->busClock;
+
+    bus->stats.transactions++;
+    bus->stats.bytes += (uint32_t) byteCount + 1;
+    bus->stats.busTimeNs += ns;
+    if (bus->freeNs < simTimeNs)
+        bus->freeNs = simTimeNs;
+    bus->freeNs += ns;
+}
+
+static void busError(sim_bus_t *bus, i2c_host_error_t error) {
+    bus->errorState = error;
+    if (bus->errorCallback != NULL)
+        bus->errorCallback();
+}
+
+// Returns the addressed device, or NULL after flagging an address NACK
+
+static ht16k33_sim_device_t *busSelect(sim_bus_t *bus, uint16_t address) {
+    ht16k33_sim_device_t *dev = deviceLookup(bus, address);
+
+    bus->errorState = I2C_ERROR_NONE;
+    if (dev == NULL || !dev->attached) {
+        bus->stats.addrNacks++;
+        busCharge(bus, 0);
+        busError(bus, I2C_ERROR_ADDR_NACK);
+        return NULL;
+    }
+    return dev;
+}
+
+static void deviceCommand(ht16k33_sim_device_t *dev, const uint8_t *data, size_t dataLength) {
+    uint8_t cmd = data[0];
+
+    if (dev->foreign) {
+        dev->foreignRegister = data[dataLength - 1];
+        return;
+    }
+    dev->keyAddressed = false;
+    if ((cmd & HT16K33_CMD_RAM_MASK) == HT16K33_CMD_KEY_RAM) {
+        dev->keyAddressed = true;
+        dev->keyPointer = cmd & 0x0F;
+    } else if ((cmd & HT16K33_CMD_RAM_MASK) == HT16K33_CMD_RAM) {
+        dev->addressPointer = cmd & 0x0F;
+        if (dataLength > 1) {
+            dev->ramWrites++;
+            for (size_t i = 1; i < dataLength; i++) {
+                dev->displayRAM[dev->addressPointer] = data[i];
+                dev->addressPointer = (dev->addressPointer + 1) & 0x0F; // Auto increment wraps within display RAM
+                dev->ramBytesWritten++;
+            }
+        }
+    } else if ((cmd & HT16K33_CMD_RAM_MASK) == HT16K33_CMD_SYSTEM_SETUP) {
+        dev->oscillatorOn = cmd & 0x01;
+        dev->systemSetupWrites++;
+    } else if ((cmd & HT16K33_CMD_RAM_MASK) == HT16K33_CMD_DISPLAY_SETUP) {
+        dev->displayOn = cmd & 0x01;
+        dev->blinkRate = (cmd >> 1) & 0x03;
+        dev->displaySetupWrites++;
+    } else if ((cmd & HT16K33_CMD_RAM_MASK) == HT16K33_CMD_ROW_INT) {
+        dev->intOutput = cmd & 0x01;
+        dev->intActiveHigh = (cmd >> 1) & 0x01;
+    } else if ((cmd & HT16K33_CMD_RAM_MASK) == HT16K33_CMD_DIMMING) {
+        dev->dimming = cmd & 0x0F;
+        dev->dimmingWrites++;
+    }
+}
+
+static void deviceRead(ht16k33_sim_device_t *dev, uint8_t *data, size_t dataLength) {
+    if (dev->foreign) {
+        memset(data, dev->foreignRegister, dataLength);
+        return;
+    }
+    if (dev->keyAddressed) {
+        dev->keyReads++;
+        for (size_t i = 0; i < dataLength; i++) {
+            data[i] = dev->keyPointer < HT16K33_KEY_RAM_SIZE ? dev->keyRAM[dev->keyPointer] : 0;
+            dev->keyPointer++;
+        }
+        return;
+    }
+    for (size_t i = 0; i < dataLength; i++) {
+        data[i] = dev->displayRAM[dev->addressPointer];
+        dev->addressPointer = (dev->addressPointer + 1) & 0x0F;
+    }
+}
+
+// Completion callbacks in the driver's order: the transfer's own, then the bus-wide one
+
+static void transferEnd(sim_bus_t *bus) {
+    i2c_host_transfer_callback_t callback = bus->transfer.callback;
+
+    bus->transfer.callback = NULL; // The callback may start the next transfer with its own
+    if (callback != NULL)
+        callback(bus->errorState, bus->transfer.context);
+    if (bus->transferDoneCallback != NULL)
+        bus->transferDoneCallback();
+}
+
+static void transferComplete(sim_bus_t *bus) {
+    sim_transfer_t *transfer = &bus->transfer;
+    ht16k33_sim_device_t *dev;
+
+    transfer->busy = false;
+    dev = busSelect(bus, transfer->address);
+    if (dev == NULL) {
+        transferEnd(bus);
+        return;
+    }
+
+    if (transfer->switchToRead) {
+        // Repeated start: both phases are charged, only one Stop is counted as a transaction
+        busCharge(bus, transfer->writeLength + 1 + transfer->readLength);
+        if (transfer->writeLength > 0)
+            deviceCommand(dev, transfer->writePtr, transfer->writeLength);
+        deviceRead(dev, transfer->readPtr, transfer->readLength);
+    } else if (transfer->readPtr != NULL) {
+        busCharge(bus, transfer->readLength);
+        deviceRead(dev, transfer->readPtr, transfer->readLength);
+    } else {
+        busCharge(bus, transfer->writeLength);
+        if (transfer->writeLength > 0)
+            deviceCommand(dev, transfer->writePtr, transfer->writeLength);
+    }
+
+    transferEnd(bus);
+}
+
+static bool transferStart(sim_bus_t *bus, uint16_t address, uint8_t *writeData, size_t writeLength, uint8_t *readData, size_t readLength,
+        bool switchToRead, i2c_host_transfer_callback_t callback, void *context) {
+    sim_transfer_t *transfer = &bus->transfer;
+
+    if (transfer->busy) {
+        bus->stats.rejectedBusy++;
+        return false;
+    }
+
+    transfer->busy = true;
+    transfer->address = address;
+    transfer->writePtr = writeData;
+    transfer->writeLength = writeLength;
+    transfer->readPtr = readData;
+    transfer->readLength = readLength;
+    transfer->switchToRead = switchToRead;
+    transfer->callback = callback;
+    transfer->context = context;
+    bus->errorState = I2C_ERROR_NONE;
+
+    if (!asyncMode)
+        transferComplete(bus);
+    return true;
+}
+
+static bool transferSetup(sim_bus_t *bus, i2c_host_transfer_setup_t *setup) {
+    if (setup == NULL || setup->clkSpeed == 0)
+        return false;
+    bus->busClock = setup->clkSpeed;
+    return true;
+}
+
+static i2c_host_error_t errorGet(sim_bus_t *bus) {
+    i2c_host_error_t retErrorState = bus->errorState;
+    bus->errorState = I2C_ERROR_NONE;
+    return retErrorState;
+}
+
+// The vtable functions of bus n, each a thin wrapper around the shared code
+#define SIM_BUS_INTERFACE(n, name) \
+    static void name##_Initialize(void) { \
+        buses[n].errorState = I2C_ERROR_NONE; \
+    } \
+    static void name##_Deinitialize(void) { \
+        buses[n].errorCallback = NULL; \
+    } \
+    static bool name##_Write(uint16_t address, uint8_t *data, size_t dataLength) { \
+        return transferStart(&buses[n], address, data, dataLength, NULL, 0, false, NULL, NULL); \
+    } \
+    static bool name##_Read(uint16_t address, uint8_t *data, size_t dataLength) { \
+        return transferStart(&buses[n], address, NULL, 0, data, dataLength, false, NULL, NULL); \
+    } \
+    static bool name##_WriteRead(uint16_t address, uint8_t *writeData, size_t writeLength, uint8_t *readData, size_t readLength) { \
+        return transferStart(&buses[n], address, writeData, writeLength, readData, readLength, true, NULL, NULL); \
+    } \
+    static bool name##_Transfer(uint16_t address, uint8_t *writeData, size_t writeLength, uint8_t *readData, size_t readLength, \
+            i2c_host_transfer_callback_t callback, void *context) { \
+        if (readLength == 0) \
+            readData = NULL; \
+        return transferStart(&buses[n], address, writeData, writeLength, readData, readLength, writeLength != 0 && readLength != 0, \
+                callback, context); \
+    } \
+    static bool name##_TransferSetup(i2c_host_transfer_setup_t *setup, uint32_t srcClkFreq) { \
+        (void) srcClkFreq; \
+        return transferSetup(&buses[n], setup); \
+    } \
+    static i2c_host_error_t name##_ErrorGet(void) { \
+        return errorGet(&buses[n]); \
+    } \
+    static bool name##_IsBusy(void) { \
+        return buses[n].transfer.busy; \
+    } \
+    static void name##_CallbackRegister(void (*callbackHandler)(void)) { \
+        if (callbackHandler != NULL) \
+            buses[n].errorCallback = callbackHandler; \
+    } \
+    static void name##_Tasks(void) { \
+        if (buses[n].transfer.busy) \
+            transferComplete(&buses[n]); \
+    } \
+    const i2c_host_interface_t name = { \
+        .Initialize = name##_Initialize, \
+        .Deinitialize = name##_Deinitialize, \
+        .Write = name##_Write, \
+        .Read = name##_Read, \
+        .WriteRead = name##_WriteRead, \
+        .Transfer = name##_Transfer, \
+        .TransferSetup = name##_TransferSetup, \
+        .ErrorGet = name##_ErrorGet, \
+        .IsBusy = name##_IsBusy, \
+        .CallbackRegister = name##_CallbackRegister, \
+        .Tasks = name##_Tasks \
+    }
+
+SIM_BUS_INTERFACE(0, HT16K33_Sim_Host);
+SIM_BUS_INTERFACE(1, HT16K33_Sim_Host2);
+
+void HT16K33_Sim_Reset(void) {
+    memset(buses, 0, sizeof (buses));
+    for (uint8_t i = 0; i < HT16K33_SIM_BUSES; i++)
+        buses[i].busClock = HT16K33_SIM_DEFAULT_CLOCK;
+    selected = &buses[0];
+    simTimeNs = 0;
+    asyncMode = false;
+}
+
+bool HT16K33_Sim_BusSelect(uint8_t bus) {
+    if (bus >= HT16K33_SIM_BUSES)
+        return false;
+    selected = &buses[bus];
+    return true;
+}
+
+bool HT16K33_Sim_Attach(uint16_t address) {
+    ht16k33_sim_device_t *dev = deviceLookup(selected, address);
+
+    if (dev == NULL)
+        return false;
+    dev->attached = true;
+    deviceReset(dev);
+    return true;
+}
+
+bool HT16K33_Sim_AttachForeign(uint16_t address) {
+    ht16k33_sim_device_t *dev = deviceLookup(selected, address);
+
+    if (dev == NULL)
+        return false;
+    dev->attached = true;
+    deviceReset(dev);
+    dev->foreign = true;
+    return true;
+}
+
+void HT16K33_Sim_Detach(uint16_t address) {
+    ht16k33_sim_device_t *dev = deviceLookup(selected, address);
+
+    if (dev != NULL)
+        dev->attached = false;
+}
+
+bool HT16K33_Sim_Move(uint16_t from, uint16_t to) {
+    ht16k33_sim_device_t *src = deviceLookup(selected, from);
+    ht16k33_sim_device_t *dst = deviceLookup(selected, to);
+
+    if (src == NULL || dst == NULL || !src->attached || dst->attached)
+        return false;
+    *dst = *src;
+    src->attached = false;
+    return true;
+}
+
+bool HT16K33_Sim_IntAsserted(uint16_t address) {
+    ht16k33_sim_device_t *dev = deviceLookup(selected, address);
+
+    if (dev == NULL || !dev->attached || !dev->intOutput)
+        return false;
+    for (uint8_t i = 0; i < HT16K33_KEY_RAM_SIZE; i++)
+        if (dev->keyRAM[i] != 0)
+            return true;
+    return false;
+}
+
+ht16k33_sim_device_t *HT16K33_Sim_DeviceGet(uint16_t address) {
+    return deviceLookup(selected, address);
+}
+
+const ht16k33_sim_stats_t *HT16K33_Sim_StatsGet(void) {
+    return &selected->stats;
+}
+
+void HT16K33_Sim_StatsClear(void) {
+    memset(&selected->stats, 0, sizeof (selected->stats));
+    for (uint8_t i = 0; i < HT16K33_SIM_MAX_DEVICES; i++) {
+        ht16k33_sim_device_t *dev = &selected->devices[i];
+
+        dev->systemSetupWrites = 0;
+        dev->displaySetupWrites = 0;
+        dev->dimmingWrites = 0;
+        dev->ramWrites = 0;
+        dev->ramBytesWritten = 0;
+        dev->keyReads = 0;
+    }
+}
+
+void HT16K33_Sim_TransferDoneCallbackRegister(void (*callbackHandler)(void)) {
+    buses[0].transferDoneCallback = callbackHandler;
+}
+
+void HT16K33_Sim_Host2_TransferDoneCallbackRegister(void (*callbackHandler)(void)) {
+    buses[1].transferDoneCallback = callbackHandler;
+}
+
+void HT16K33_Sim_AsyncSet(bool async) {
+    asyncMode = async;
+}
+
+uint64_t HT16K33_Sim_TimeGet(void) {
+    return timeNow() / 1000;
+}
+
+void HT16K33_Sim_TimeAdvance(uint32_t microseconds) {
+    simTimeNs = timeNow() + (uint64_t) microseconds * 1000;
+}
@@ -0,0 +1,230 @@
+/**
+ * HT16K33 Host Simulator Header File
+ *
+ * @file ht16k33_sim.h
+ *
+ * @defgroup ht16k33_sim HT16K33_SIM
+ *
+ * @brief Simulated I2C bus with HT16K33 LED drivers attached, exposed through
+ *        the same i2c_host_interface_t vtable as the I2C1 driver. This lets
+ *        alphaDisplay.c be built and profiled on a desktop machine.
+ *
+ *        Host build: compile alphaDisplay.c together with the files in host/
+ *        using -Ihost so that <xc.h> resolves to the stand-in header, and
+ *        define ALPHA_HOST_SIM so the library binds to HT16K33_Sim_Host.
+ *        host/Makefile does this for every program in host/; make -C host
+ *        demo runs sim_demo.c, the smallest of them.
+ */
+
+#ifndef HT16K33_SIM_H
+#define HT16K33_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "../mcc_generated_files/i2c_host/i2c_host_interface.h"
+
+#define HT16K33_SIM_BASE_ADDRESS 0x70
+#define HT16K33_SIM_MAX_DEVICES 8
+#define HT16K33_SIM_DEFAULT_CLOCK 100000UL
+#define HT16K33_SIM_BUSES 2
+
+/**
+ * @ingroup ht16k33_sim
+ * @struct ht16k33_sim_device_t
+ * @brief Decoded register state of one simulated HT16K33.
+ */
+typedef struct {
+    bool attached; /**< Device answers on the bus*/
+    bool oscillatorOn; /**< System setup S bit*/
+    bool displayOn; /**< Display setup D bit*/
+    uint8_t blinkRate; /**< Display setup B1:B0*/
+    uint8_t dimming; /**< Dimming P3:P0*/
+    uint8_t addressPointer; /**< Display RAM address pointer*/
+    uint8_t displayRAM[16]; /**< Display data RAM*/
+    uint8_t keyRAM[6]; /**< Key data RAM: K1, K2, K3 as 13-bit little endian row masks*/
+    bool keyAddressed; /**< Last address pointer set was in key data RAM*/
+    uint8_t keyPointer; /**< Key data RAM address pointer*/
+    uint32_t keyReads; /**< Read transactions from key data RAM*/
+    bool intOutput; /**< ROW/INT set: ROW15 pin is the key interrupt*/
+    bool intActiveHigh; /**< ROW/INT set: INT polarity*/
+    uint32_t systemSetupWrites; /**< System setup commands decoded*/
+    uint32_t displaySetupWrites; /**< Display setup commands decoded*/
+    uint32_t dimmingWrites; /**< Dimming commands decoded*/
+    uint32_t ramWrites; /**< Display RAM write transactions*/
+    uint32_t ramBytesWritten; /**< Display RAM bytes written*/
+    bool foreign; /**< Not an HT16K33 but a one-register device, see HT16K33_Sim_AttachForeign()*/
+    uint8_t foreignRegister; /**< Last byte written to a foreign device*/
+} ht16k33_sim_device_t;
+
+/**
+ * @ingroup ht16k33_sim
+ * @struct ht16k33_sim_stats_t
+ * @brief Bus level counters accumulated across all transfers.
+ */
+typedef struct {
+    uint32_t transactions; /**< Start..Stop sequences*/
+    uint32_t bytes; /**< Bytes clocked on the bus, address bytes included*/
+    uint32_t addrNacks; /**< Transfers to an address nobody answered*/
+    uint32_t rejectedBusy; /**< Requests refused because the bus was busy*/
+    uint64_t busTimeNs; /**< Time SCL was driven*/
+} ht16k33_sim_stats_t;
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Simulated bus, usable anywhere an i2c_host_interface_t is expected.
+ */
+extern const i2c_host_interface_t HT16K33_Sim_Host;
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Second simulated bus with its own devices, standing in for a second
+ *        I2C module. Its transfers overlap in time with those on the first.
+ */
+extern const i2c_host_interface_t HT16K33_Sim_Host2;
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Detaches every device on every bus, clears all counters and
+ *        simulated time, restores the default bus clocks and selects bus 0.
+ * @param void
+ * @return void
+ */
+void HT16K33_Sim_Reset(void);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Selects the bus that the device and counter functions below act
+ *        on: 0 for HT16K33_Sim_Host, 1 for HT16K33_Sim_Host2.
+ * @param [in] bus - Bus number.
+ * @return true on success, false if there is no such bus.
+ */
+bool HT16K33_Sim_BusSelect(uint8_t bus);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Attaches a power-on-reset HT16K33 at address on the selected bus.
+ * @param [in] address - 7-bit address in the range 0x70 - 0x77.
+ * @return true on success, false if the address is out of range.
+ */
+bool HT16K33_Sim_Attach(uint16_t address);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Attaches a device other than an HT16K33 at address on the selected
+ *        bus, modelled on a PCA9548 I2C switch: it acknowledges, keeps the
+ *        last byte written in its one register and returns that register for
+ *        every byte read.
+ * @param [in] address - 7-bit address in the range 0x70 - 0x77.
+ * @return true on success, false if the address is out of range.
+ */
+bool HT16K33_Sim_AttachForeign(uint16_t address);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Removes the device at address from the bus; it will NACK from now on.
+ * @param [in] address - 7-bit address in the range 0x70 - 0x77.
+ * @return void
+ */
+void HT16K33_Sim_Detach(uint16_t address);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Moves the device at from to the address to, keeping its state, as
+ *        when the ADR pins are pulled by the ROW/COM drivers they share.
+ * @param [in] from - 7-bit address of an attached device, 0x70 - 0x77.
+ * @param [in] to - 7-bit address of a free slot, 0x70 - 0x77.
+ * @return true on success, false if from is empty, to is taken or either
+ *         is out of range.
+ */
+bool HT16K33_Sim_Move(uint16_t from, uint16_t to);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Level of the ROW15/INT pin of the device at address, modelled as
+ *        asserted while INT output is selected and any key is down.
+ * @param [in] address - 7-bit address in the range 0x70 - 0x77.
+ * @return true while the pin is at its active level.
+ */
+bool HT16K33_Sim_IntAsserted(uint16_t address);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Returns the register state of the device slot for address.
+ * @param [in] address - 7-bit address in the range 0x70 - 0x77.
+ * @return Pointer to the device, or NULL if address is out of range.
+ */
+ht16k33_sim_device_t *HT16K33_Sim_DeviceGet(uint16_t address);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Returns the counters of the selected bus.
+ * @param void
+ * @return Pointer to the live counters.
+ */
+const ht16k33_sim_stats_t *HT16K33_Sim_StatsGet(void);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Clears the counters of the selected bus and of its devices.
+ * @param void
+ * @return void
+ */
+void HT16K33_Sim_StatsClear(void);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Counterpart of I2C1_TransferDoneCallbackRegister(): the callback runs
+ *        after every transfer, successful or not, with the bus already idle.
+ * @param CallbackHandler - Pointer to custom Callback, NULL to unregister.
+ * @return void
+ */
+void HT16K33_Sim_TransferDoneCallbackRegister(void (*callbackHandler)(void));
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief HT16K33_Sim_TransferDoneCallbackRegister() for HT16K33_Sim_Host2.
+ * @param CallbackHandler - Pointer to custom Callback, NULL to unregister.
+ * @return void
+ */
+void HT16K33_Sim_Host2_TransferDoneCallbackRegister(void (*callbackHandler)(void));
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Selects when transfers complete. Synchronous transfers finish inside
+ *        Write/Read/WriteRead. Asynchronous transfers keep the bus busy and
+ *        read the caller's buffer only when HT16K33_Sim_Host.Tasks() runs.
+ * @param [in] async - true for asynchronous completion.
+ * @return void
+ */
+void HT16K33_Sim_AsyncSet(bool async);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Simulated time in microseconds: the later of the time delays have
+ *        advanced to and the end of the last transaction on each bus. Every
+ *        bus has its own clock, so traffic on two buses runs in parallel.
+ * @param void
+ * @return Elapsed simulated microseconds since HT16K33_Sim_Reset().
+ */
+uint64_t HT16K33_Sim_TimeGet(void);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Advances simulated time without bus activity.
+ * @param [in] microseconds - Time to add.
+ * @return void
+ */
+void HT16K33_Sim_TimeAdvance(uint32_t microseconds);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Fake clock (host/tmr0_host.c): advances simulated time one TMR0
+ *        period at a time, firing the overflow callback for each period
+ *        while TMR0 is started.
+ * @param [in] milliseconds - Time to add.
+ * @return void
+ */
+void TMR0_Host_Advance(uint32_t milliseconds);
+
+#endif /* HT16K33_SIM_H */
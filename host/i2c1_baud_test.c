@@ -0,0 +1,101 @@
+/**
+ * I2C1 SCL Rate Test
+ *
+ * @file i2c1_baud_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Sets SCL rates through I2C1_TransferSetup() on the register model
+ *        and checks the I2C1BAUD, FME and pad slew values it picks, the SCL
+ *        frequency they give, and that requests it cannot meet leave the
+ *        module untouched.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <xc.h>
+#include "i2c1_regs_sim.h"
+#include "mcc_generated_files/i2c_host/i2c1.h"
+
+#define FAST_MODE 400000UL // Above this the pads switch to Fast mode Plus slew
+#define FAST_MODE_PLUS 1000000UL // Highest rate accepted
+
+typedef struct {
+    uint32_t request; // Hz
+    uint8_t baud;
+    uint8_t fme;
+    uint32_t scl; // Hz with Fosc = _XTAL_FREQ
+} rate_case_t;
+
+// 40 MHz Fosc: SCL = Fosc / ((BAUD + 1) * 5), or * 4 with FME
+static const rate_case_t rates[] = {
+    {100000, 79, 0, 100000},
+    {400000, 19, 0, 400000},
+    {1000000, 7, 0, 1000000},
+    {50000, 159, 0, 50000},
+    {333333, 30, 1, 322580}, // /4 lands closer than /5, which would give 320 kHz
+    {150000, 66, 1, 149253},
+};
+
+static int failures;
+
+static void expect(bool condition, const char *what, uint32_t request) {
+    if (!condition) {
+        printf("FAIL %lu Hz: %s\n", (unsigned long) request, what);
+        failures++;
+    }
+}
+
+static bool setup(uint32_t request, uint32_t srcClkFreq) {
+    i2c_host_transfer_setup_t transferSetup = {request};
+
+    return I2C1_TransferSetup(&transferSetup, srcClkFreq);
+}
+
+// A rejected request must not touch the rate set before it
+static void rejected(uint32_t request, uint32_t srcClkFreq, const char *what) {
+    uint8_t baud = I2C1BAUD;
+    uint8_t fme = I2C1CON2bits.FME;
+
+    expect(!setup(request, srcClkFreq), what, request);
+    expect(I2C1BAUD == baud && I2C1CON2bits.FME == fme, "registers unchanged after rejection", request);
+}
+
+int main(void) {
+    uint8_t frame[17] = {0};
+
+    I2C1_Regs_Sim_Reset();
+    I2C1_Regs_Sim_AckSet(0x70, true);
+    I2C1_Initialize();
+    expect(I2C1_Regs_Sim_SclFrequency() == 400000, "default rate", 400000);
+
+    for (uint8_t i = 0; i < sizeof (rates) / sizeof (rates[0]); i++) {
+        const rate_case_t *rate = &rates[i];
+        uint8_t pad = rate->request > FAST_MODE ? I2C1_PAD_FAST_PLUS : I2C1_PAD_FAST;
+        uint32_t scl;
+
+        expect(setup(rate->request, 0), "accepted", rate->request);
+        expect(I2C1BAUD == rate->baud, "I2C1BAUD", rate->request);
+        expect(I2C1CON2bits.FME == rate->fme, "FME", rate->request);
+        expect(RB1I2C == pad && RB2I2C == pad, "pad slew", rate->request);
+        scl = I2C1_Regs_Sim_SclFrequency();
+        expect(scl == rate->scl && scl <= rate->request, "SCL frequency", rate->request);
+        expect(I2C1_Write(0x70, frame, sizeof (frame)) && I2C1_Regs_Sim_Run(), "frame at the new rate", rate->request);
+        printf("%7lu Hz: BAUD %3u FME %u -> SCL %7lu Hz\n", (unsigned long) rate->request, I2C1BAUD, I2C1CON2bits.FME,
+               (unsigned long) scl);
+    }
+
+    rejected(0, 0, "0 Hz rejected");
+    rejected(FAST_MODE_PLUS + 1, 0, "above 1 MHz rejected");
+    rejected(30000, 0, "divider above 256 rejected");
+    expect(setup(100000, 64000000) && I2C1BAUD == 127, "64 MHz source clock", 100000);
+    rejected(10000, 64000000, "divider above 256 from a 64 MHz source rejected");
+
+    expect(I2C1_Write(0x70, frame, sizeof (frame)), "frame accepted", 100000);
+    rejected(400000, 0, "rejected while a transfer is in progress");
+    expect(I2C1_Regs_Sim_Run(), "frame finished", 100000);
+
+    printf("SCL rate: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
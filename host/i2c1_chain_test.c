@@ -0,0 +1,89 @@
+/**
+ * I2C1 Chained Transfer Test
+ *
+ * @file i2c1_chain_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Starts each transfer from the completion callback of the one before
+ *        it, on the register model. The callback runs on the Stop interrupt,
+ *        before BFRE sets, so each chained start has to be accepted there and
+ *        held by the module until the bus is free.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <xc.h>
+#include "i2c1_regs_sim.h"
+#include "mcc_generated_files/i2c_host/i2c1.h"
+
+#define PRESENT 0x70
+#define CHAIN 4
+#define FRAME_BYTES 5
+#define MODE (I2C1_DMA_TX ? "DMA" : "interrupt")
+
+static int failures;
+static uint8_t frames[CHAIN][FRAME_BYTES];
+static int callbacks;
+static int accepted;
+static int busFreeInCallback;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void onTransfer(i2c_host_error_t error, void *context) {
+    int index = (int) (intptr_t) context;
+
+    (void) error;
+    callbacks++;
+    if (I2C1STAT0bits.BFRE)
+        busFreeInCallback++;
+    if (index + 1 < CHAIN &&
+            I2C1_Transfer(PRESENT, frames[index + 1], FRAME_BYTES, NULL, 0, onTransfer, (void *) (intptr_t) (index + 1)))
+        accepted++;
+}
+
+int main(void) {
+    i2c_host_stats_t driverStats;
+    size_t length;
+    const uint8_t *log;
+
+    for (uint8_t f = 0; f < CHAIN; f++)
+        for (uint8_t i = 0; i < FRAME_BYTES; i++)
+            frames[f][i] = (uint8_t) (f * 16 + i);
+
+    I2C1_Regs_Sim_Reset();
+    I2C1_Regs_Sim_AckSet(PRESENT, true);
+    I2C1_Initialize();
+
+    expect(I2C1_Transfer(PRESENT, frames[0], FRAME_BYTES, NULL, 0, onTransfer, (void *) (intptr_t) 0), "first transfer accepted");
+    expect(I2C1_Regs_Sim_Run() && !I2C1_IsBusy(), "chain finished");
+    expect(busFreeInCallback == 0, "callbacks ran before BFRE set");
+    expect(accepted == CHAIN - 1, "every start from a callback accepted");
+    expect(callbacks == CHAIN, "one callback per transfer");
+
+    log = I2C1_Regs_Sim_BusLog(&length);
+    expect(length == CHAIN * (FRAME_BYTES + 1), "every frame on the bus");
+    for (uint8_t f = 0; f < CHAIN && length == CHAIN * (FRAME_BYTES + 1); f++) {
+        const uint8_t *frame = log + f * (FRAME_BYTES + 1);
+
+        expect(frame[0] == PRESENT << 1 && memcmp(frame + 1, frames[f], FRAME_BYTES) == 0, "frames in chain order");
+    }
+
+    I2C1_StatsGet(&driverStats);
+    expect(driverStats.rejectedBusy == 0, "no start refused");
+
+    // A start made while a transfer is open is still refused
+    expect(I2C1_Write(PRESENT, frames[0], FRAME_BYTES), "write accepted");
+    expect(!I2C1_Write(PRESENT, frames[1], FRAME_BYTES), "second write refused while the first is open");
+    expect(I2C1_Regs_Sim_Run(), "write finished");
+
+    printf("%s chained transfers: %s\n", MODE, failures ? "FAILED" : "passed");
+    return failures != 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * I2C1 Transmit Path Test
+ *
+ * @file i2c1_dma_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Sends display frames through the I2C1 driver on the register model
+ *        and counts the interrupts each one takes. host/Makefile builds it
+ *        with and without I2C1_DMA_TX, so the two lines it prints compare
+ *        interrupt-driven transmit with DMA transmit. Also covers an address
+ *        NACK, a zero-length probe right after it and a write-read.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <xc.h>
+#include "i2c1_regs_sim.h"
+#include "mcc_generated_files/i2c_host/i2c1.h"
+
+#define PRESENT 0x70
+#define ABSENT 0x71
+#define FRAMES 10
+#define FRAME_BYTES 17 // Display RAM pointer and 16 bytes of display RAM
+#define MODE (I2C1_DMA_TX ? "DMA" : "interrupt")
+
+static int failures;
+static int transfersDone;
+static int errorCallbacks;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void onTransferDone(void) {
+    transfersDone++;
+}
+
+static void onError(void) {
+    errorCallbacks++;
+}
+
+// Bytes put on SDA since the log was at length before
+static bool logged(size_t before, uint8_t address, const uint8_t *data, size_t dataLength) {
+    size_t length;
+    const uint8_t *log = I2C1_Regs_Sim_BusLog(&length);
+
+    return length - before == dataLength + 1 && log[before] == (uint8_t) (address << 1) &&
+            (dataLength == 0 || memcmp(log + before + 1, data, dataLength) == 0);
+}
+
+int main(void) {
+    const i2c1_regs_sim_stats_t *stats = I2C1_Regs_Sim_StatsGet();
+    uint8_t frame[FRAME_BYTES];
+    uint8_t pointer = 0x00;
+    uint8_t readData[4];
+    size_t before;
+
+    for (uint8_t i = 0; i < FRAME_BYTES; i++)
+        frame[i] = (uint8_t) (i * 7);
+
+    I2C1_Regs_Sim_Reset();
+    I2C1_Regs_Sim_AckSet(PRESENT, true);
+    I2C1_Initialize();
+    I2C1_TransferDoneCallbackRegister(onTransferDone);
+    I2C1_CallbackRegister(onError);
+
+    for (uint8_t f = 0; f < FRAMES; f++) {
+        I2C1_Regs_Sim_BusLog(&before);
+        expect(I2C1_Write(PRESENT, frame, sizeof (frame)), "frame accepted");
+        expect(I2C1_Regs_Sim_Run(), "frame finished");
+        expect(logged(before, PRESENT, frame, sizeof (frame)), "frame on the bus byte for byte");
+    }
+    expect(transfersDone == FRAMES, "transfer done callback once per frame");
+    printf("%-9s transmit: %.1f interrupts per %u-byte frame (tx %u, event %u, error %u), %u bytes moved by DMA\n",
+           MODE, (double) stats->interrupts / FRAMES, FRAME_BYTES, stats->txInterrupts, stats->eventInterrupts,
+           stats->errorInterrupts, stats->dmaTransfers);
+#if I2C1_DMA_TX
+    expect(stats->txInterrupts == 0 && stats->dmaTransfers == FRAMES * FRAME_BYTES, "every data byte moved by DMA1");
+    expect(stats->interrupts == FRAMES * 2, "count and Stop interrupts only");
+#else
+    expect(stats->txInterrupts == FRAMES * FRAME_BYTES && stats->dmaTransfers == 0, "one TX interrupt per data byte");
+    expect(stats->interrupts == FRAMES * (FRAME_BYTES + 2), "TX, count and Stop interrupts");
+#endif
+
+    transfersDone = 0;
+    I2C1_Regs_Sim_BusLog(&before);
+    expect(I2C1_Write(ABSENT, frame, sizeof (frame)), "NACKed frame accepted");
+    expect(I2C1_Regs_Sim_Run() && !I2C1_IsBusy(), "NACKed frame released the bus");
+    expect(errorCallbacks == 1 && I2C1_ErrorGet() == I2C_ERROR_ADDR_NACK, "NACK reported");
+    expect(logged(before, ABSENT, NULL, 0), "NACKed frame stopped after the address");
+
+    I2C1_Regs_Sim_BusLog(&before);
+    expect(I2C1_Write(PRESENT, NULL, 0), "probe accepted");
+    expect(I2C1_Regs_Sim_Run() && !I2C1_IsBusy(), "probe after NACK released the bus");
+    expect(I2C1_ErrorGet() == I2C_ERROR_NONE, "probe after NACK acknowledged");
+    expect(logged(before, PRESENT, NULL, 0), "probe after NACK sent the address alone");
+
+    expect(I2C1_WriteRead(PRESENT, &pointer, 1, readData, sizeof (readData)), "write-read accepted");
+    expect(I2C1_Regs_Sim_Run() && !I2C1_IsBusy(), "write-read finished");
+    expect(stats->rxInterrupts == sizeof (readData), "one RX interrupt per byte read");
+    expect(transfersDone == 3, "transfer done callback after NACK, probe and write-read");
+
+    printf("%s transmit: %s\n", MODE, failures ? "FAILED" : "passed");
+    return failures != 0;
+}
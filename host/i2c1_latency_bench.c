@@ -0,0 +1,54 @@
+/**
+ * I2C1 Interrupt Dispatch Benchmark
+ *
+ * @file i2c1_latency_bench.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Sends display frames through the I2C1 driver on the register model,
+ *        once through the polled INTERRUPT_InterruptManager chain and once
+ *        through the vector table of an INTERRUPT_VECTORED build, and counts
+ *        the enable/flag tests the polled chain makes before it reaches an
+ *        ISR. That is the dispatch latency the vector table removes.
+ *        host/Makefile builds it with and without I2C1_DMA_TX.
+ *
+ *        Build and run: make -C host bench
+ *
+ *        Only counts are reported. The model does not run PIC18 code, so
+ *        what a test or an interrupt entry costs in cycles is left to a
+ *        measurement on silicon.
+ */
+
+#include <stdio.h>
+#include <xc.h>
+#include "i2c1_regs_sim.h"
+#include "mcc_generated_files/i2c_host/i2c1.h"
+
+#define FRAMES 100
+#define FRAME_BYTES 17
+
+int main(void) {
+    uint8_t frame[FRAME_BYTES] = {0};
+
+    for (uint8_t vectored = 0; vectored < 2; vectored++) {
+        const i2c1_regs_sim_stats_t *stats;
+
+        I2C1_Regs_Sim_Reset();
+        I2C1_Regs_Sim_VectoredSet(vectored);
+        I2C1_Regs_Sim_AckSet(0x70, true);
+        I2C1_Initialize();
+        for (uint8_t f = 0; f < FRAMES; f++) {
+            if (!I2C1_Write(0x70, frame, sizeof (frame)) || !I2C1_Regs_Sim_Run()) {
+                printf("frame %u did not complete\n", f);
+                return 1;
+            }
+        }
+
+        stats = I2C1_Regs_Sim_StatsGet();
+        printf("%-8s %-9s transmit: %5u interrupts (%4u TX, %3u event), %5u dispatch tests, %.2f per interrupt\n",
+               vectored ? "vectored" : "polled", I2C1_DMA_TX ? "DMA" : "interrupt", stats->interrupts, stats->txInterrupts,
+               stats->eventInterrupts, stats->dispatchTests,
+               stats->interrupts ? (double) stats->dispatchTests / stats->interrupts : 0.0);
+    }
+    return 0;
+}
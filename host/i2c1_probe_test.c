@@ -0,0 +1,77 @@
+/**
+ * I2C1 Address Probe Test
+ *
+ * @file i2c1_probe_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Runs zero-length writes, the probes of the link recovery, on the
+ *        register model right after writes that were NACKed part way, while
+ *        I2C1CNT still holds what was left of their count. A probe must put
+ *        the address byte alone on the bus and end with a Stop.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <xc.h>
+#include "i2c1_regs_sim.h"
+#include "mcc_generated_files/i2c_host/i2c1.h"
+
+#define PRESENT 0x70
+#define ABSENT 0x71
+
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+// Runs one transfer to completion and checks its result and the bytes it put on SDA
+static void transfer(const char *what, uint8_t address, uint8_t *data, size_t dataLength, i2c_host_error_t error,
+        const uint8_t *expected, size_t expectedLength) {
+    size_t before, after;
+    const uint8_t *log = I2C1_Regs_Sim_BusLog(&before);
+    bool ran;
+    char text[96];
+
+    expect(I2C1_Write(address, data, dataLength), what);
+    ran = I2C1_Regs_Sim_Run();
+    log = I2C1_Regs_Sim_BusLog(&after);
+
+    snprintf(text, sizeof (text), "%s: bus did not go idle", what);
+    expect(ran && !I2C1_IsBusy(), text);
+    snprintf(text, sizeof (text), "%s: error state", what);
+    expect(I2C1_ErrorGet() == error, text);
+    snprintf(text, sizeof (text), "%s: bytes on the bus", what);
+    expect(after - before == expectedLength && memcmp(log + before, expected, expectedLength) == 0, text);
+}
+
+int main(void) {
+    uint8_t frame[17];
+    const uint8_t presentWrite[] = {PRESENT << 1};
+    const uint8_t absentWrite[] = {ABSENT << 1};
+    uint8_t frameWrite[1 + sizeof (frame)] = {PRESENT << 1};
+
+    for (uint8_t i = 0; i < sizeof (frame); i++)
+        frame[i] = (uint8_t) (0xA0 + i);
+    memcpy(frameWrite + 1, frame, sizeof (frame));
+
+    I2C1_Regs_Sim_Reset();
+    I2C1_Regs_Sim_AckSet(PRESENT, true);
+    I2C1_Initialize();
+
+    transfer("NACKed frame", ABSENT, frame, sizeof (frame), I2C_ERROR_ADDR_NACK, absentWrite, 1);
+    transfer("probe after NACKed frame", PRESENT, NULL, 0, I2C_ERROR_NONE, presentWrite, 1);
+    transfer("NACKed command", ABSENT, frame, 3, I2C_ERROR_ADDR_NACK, absentWrite, 1);
+    transfer("probe of absent display after NACKed command", ABSENT, NULL, 0, I2C_ERROR_ADDR_NACK, absentWrite, 1);
+    transfer("probe", PRESENT, NULL, 0, I2C_ERROR_NONE, presentWrite, 1);
+    transfer("frame after probe", PRESENT, frame, sizeof (frame), I2C_ERROR_NONE, frameWrite, sizeof (frameWrite));
+
+    printf("%s: %s\n", I2C1_DMA_TX ? "DMA transmit" : "interrupt transmit", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
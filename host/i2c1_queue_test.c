@@ -0,0 +1,81 @@
+/**
+ * I2C Queue Interrupt Chaining Test
+ *
+ * @file i2c1_queue_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Queues several writes for the I2C1 driver on the register model and
+ *        runs the bus once without calling I2CQueue_Tasks(). Every queued
+ *        write has to reach the bus, so each one was started from the
+ *        completion callback of the one before it, in interrupt context.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <xc.h>
+#include "i2c1_regs_sim.h"
+#include "i2cQueue.h"
+#include "mcc_generated_files/i2c_host/i2c1.h"
+
+#define PRESENT 0x70
+#define WRITES 6
+#define FRAME_BYTES 9
+#define MODE (I2C1_DMA_TX ? "DMA" : "interrupt")
+
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+int main(void) {
+    uint8_t frames[WRITES][FRAME_BYTES];
+    volatile bool pending[WRITES];
+    volatile i2c_host_error_t errors[WRITES];
+    i2c_host_stats_t driverStats;
+    size_t length;
+    const uint8_t *log;
+    uint8_t inFlight = 0;
+
+    for (uint8_t w = 0; w < WRITES; w++)
+        for (uint8_t i = 0; i < FRAME_BYTES; i++)
+            frames[w][i] = (uint8_t) (w * 16 + i);
+
+    I2C1_Regs_Sim_Reset();
+    I2C1_Regs_Sim_AckSet(PRESENT, true);
+    I2C1_Initialize();
+    I2CQueue_Initialize();
+
+    for (uint8_t w = 0; w < WRITES; w++) {
+        errors[w] = I2C_ERROR_NONE;
+        expect(I2CQueue_WriteBuffer(&I2C1_Host, PRESENT, frames[w], FRAME_BYTES, &pending[w], &errors[w]), "write queued");
+    }
+    expect(I2CQueue_Depth() == WRITES, "all writes queued behind the first");
+
+    // No I2CQueue_Tasks() from here on: only the Stop interrupt can start the next write
+    expect(I2C1_Regs_Sim_Run(), "bus went idle");
+    expect(I2CQueue_Depth() == 0, "queue drained from the interrupt");
+    for (uint8_t w = 0; w < WRITES; w++)
+        inFlight += pending[w] || errors[w] != I2C_ERROR_NONE;
+    expect(inFlight == 0, "every write completed without an error");
+
+    log = I2C1_Regs_Sim_BusLog(&length);
+    expect(length == WRITES * (FRAME_BYTES + 1), "every write on the bus");
+    for (uint8_t w = 0; w < WRITES && length == WRITES * (FRAME_BYTES + 1); w++) {
+        const uint8_t *frame = log + w * (FRAME_BYTES + 1);
+
+        expect(frame[0] == PRESENT << 1 && memcmp(frame + 1, frames[w], FRAME_BYTES) == 0, "writes in queue order");
+    }
+
+    I2C1_StatsGet(&driverStats);
+    expect(driverStats.started == WRITES && driverStats.rejectedBusy == 0, "each write started once, none refused");
+
+    printf("%s queue chaining: %s\n", MODE, failures ? "FAILED" : "passed");
+    return failures != 0;
+}
@@ -0,0 +1,331 @@
+/**
+ * PIC18 I2C1 Register Model Source File
+ *
+ * @file i2c1_regs_sim.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Byte-level behaviour of I2C1 in host mode with auto stop, and of a
+ *        DMA1 channel set up for peripheral-triggered single byte moves.
+ *        TMR1 counts in bus time, so the driver can time its transfers.
+ *        Register writes made by the driver are picked up the next time the
+ *        model looks at them, which is enough for the driver's sequencing.
+ */
+
+#include <string.h>
+#include <xc.h>
+#include "i2c1_regs_sim.h"
+#include "../mcc_generated_files/i2c_host/i2c1.h"
+#include "../mcc_generated_files/system/clock.h"
+
+// Register storage for pic18_sfr.h
+volatile I2C1CON0bits_t I2C1CON0bits;
+volatile I2C1CON1bits_t I2C1CON1bits;
+volatile I2C1CON2bits_t I2C1CON2bits;
+volatile I2C1PIRbits_t I2C1PIRbits;
+volatile I2C1PIEbits_t I2C1PIEbits;
+volatile I2C1ERRbits_t I2C1ERRbits;
+volatile I2C1STAT0bits_t I2C1STAT0bits;
+volatile I2C1STAT1bits_t I2C1STAT1bits;
+volatile PIE7bits_t PIE7bits;
+volatile PIR7bits_t PIR7bits;
+volatile INTCON0bits_t INTCON0bits;
+volatile DMAnCON0bits_t DMAnCON0bits;
+volatile PRLOCKbits_t PRLOCKbits;
+volatile T1CONbits_t T1CONbits;
+volatile uint8_t I2C1CLK, I2C1CNTL, I2C1CNTH, I2C1BAUD, I2C1BTOC, I2C1ADB1, I2C1TXB, I2C1RXB;
+volatile uint8_t RB1I2C, RB2I2C;
+volatile uint8_t DMASELECT, DMAnCON1, DMAnSIRQ, DMAnAIRQ, DMAnDSZ, ISRPR, MAINPR, DMA1PR;
+volatile __uint24 DMAnSSA;
+volatile uint16_t DMAnSSZ;
+volatile uint16_t DMAnDSA;
+volatile uint8_t T1GCON, T1GATE, T1CLK, TMR1H, TMR1L;
+
+#define DMA_SSTP 0x01 // DMAnCON1: clear SIRQEN when the source count reloads
+#define STALL_LIMIT 8
+#define SCL_PER_BYTE 9 // Eight data bits and the acknowledge
+
+typedef enum {
+    BUS_IDLE,
+    BUS_WRITE,
+    BUS_READ,
+    BUS_WAIT_STOP, // NACKed, waiting for the driver to request a Stop
+    BUS_FREE_WAIT, // Stopped, BFRE still clear for the BFRET time
+    BUS_WAIT_RESTART // Count reached with RSEN set, waiting for the next Start
+} bus_state_t;
+
+static bus_state_t state;
+static bool vectored;
+static bool ackList[128];
+static bool txbEmpty;
+static uint16_t dmaIndex;
+static i2c1_regs_sim_stats_t stats;
+static uint8_t busLog[I2C1_REGS_SIM_LOG_SIZE];
+static size_t busLogLength;
+static uint32_t tmr1Cycles; // Fosc cycles not yet worth a TMR1 count
+
+// Fosc cycles per TMR1 count, 0 while TMR1 is off or on a clock the model lacks
+static uint32_t tmr1Divider(void) {
+    if (!T1CONbits.ON)
+        return 0;
+    switch (T1CLK) {
+        case 0x1: return 4U << T1CONbits.CKPS;
+        case 0x2: return 1U << T1CONbits.CKPS;
+        default: return 0;
+    }
+}
+
+// Bus time passes in I2C1CLK pulses; TMR1 follows it
+static void clockAdvance(uint32_t pulses) {
+    uint32_t divider = tmr1Divider();
+    uint16_t count;
+
+    if (divider == 0)
+        return;
+    tmr1Cycles += pulses * (I2C1CLK == 0x0 ? 4U : 1U);
+    count = (uint16_t) ((TMR1H << 8) | TMR1L);
+    count += (uint16_t) (tmr1Cycles / divider);
+    tmr1Cycles %= divider;
+    TMR1H = (uint8_t) (count >> 8);
+    TMR1L = (uint8_t) count;
+}
+
+static void sclAdvance(uint32_t periods) {
+    stats.sclPeriods += periods;
+    clockAdvance(periods * (I2C1BAUD + 1U) * (I2C1CON2bits.FME ? 4U : 5U));
+}
+
+static void logByte(uint8_t data) {
+    stats.bytes++;
+    sclAdvance(SCL_PER_BYTE);
+    if (busLogLength < I2C1_REGS_SIM_LOG_SIZE)
+        busLog[busLogLength++] = data;
+}
+
+static uint16_t countGet(void) {
+    return (uint16_t) ((I2C1CNTH << 8) | I2C1CNTL);
+}
+
+static void countSet(uint16_t count) {
+    I2C1CNTH = (uint8_t) (count >> 8);
+    I2C1CNTL = (uint8_t) count;
+}
+
+// PIR7 summary flags follow the module's flag and enable registers
+static void summaryUpdate(void) {
+    PIR7bits.I2C1IF = (I2C1PIR & I2C1PIE) != 0;
+    PIR7bits.I2C1EIF = (I2C1ERRbits.NACKIF && I2C1ERRbits.NACKIE) || (I2C1ERRbits.BCLIF && I2C1ERRbits.BCLIE) ||
+            (I2C1ERRbits.BTOIF && I2C1ERRbits.BTOIE);
+}
+
+// Enable/flag test of the polled manager, counted; the vector table needs none
+static bool pending(bool enable, bool flag) {
+    if (!vectored)
+        stats.dispatchTests++;
+    return enable && flag;
+}
+
+// Take one interrupt, choosing the ISR in INTERRUPT_InterruptManager's order
+static bool interruptManager(void) {
+    summaryUpdate();
+    if (!((PIE7bits.value & PIR7bits.value) & 0x0F))
+        return false; // Nothing to take
+
+    stats.interrupts++;
+    if (pending(PIE7bits.I2C1EIE, PIR7bits.I2C1EIF)) {
+        stats.errorInterrupts++;
+        I2C1_ERROR_ISR();
+    } else if (pending(PIE7bits.I2C1RXIE, PIR7bits.I2C1RXIF)) {
+        stats.rxInterrupts++;
+        PIR7bits.I2C1RXIF = 0; // Reading I2C1RXB clears it
+        I2C1_RX_ISR();
+    } else if (pending(PIE7bits.I2C1IE, PIR7bits.I2C1IF)) {
+        stats.eventInterrupts++;
+        I2C1_ISR();
+    } else if (pending(PIE7bits.I2C1TXIE, PIR7bits.I2C1TXIF)) {
+        stats.txInterrupts++;
+        PIR7bits.I2C1TXIF = 0; // Writing I2C1TXB clears it
+        txbEmpty = false;
+        I2C1_TX_ISR();
+    }
+    summaryUpdate();
+    return true;
+}
+
+static void interruptsService(void) {
+    for (uint8_t i = 0; i < STALL_LIMIT && interruptManager(); i++)
+        ;
+}
+
+// DMA1 answers its start trigger before the CPU sees the interrupt
+static bool dmaService(void) {
+    if (!DMAnCON0bits.EN || !DMAnCON0bits.SIRQEN || DMAnSIRQ != I2C1_DMA_TX_TRIGGER || !PIR7bits.I2C1TXIF)
+        return false;
+    if (DMAnDSA != (uint16_t) (uintptr_t) &I2C1TXB || DMAnSSZ == 0)
+        return false;
+
+    I2C1TXB = ((const uint8_t *) DMAnSSA)[dmaIndex];
+    PIR7bits.I2C1TXIF = 0;
+    txbEmpty = false;
+    stats.dmaTransfers++;
+    if (++dmaIndex == DMAnSSZ) {
+        dmaIndex = 0;
+        if (DMAnCON1 & DMA_SSTP)
+            DMAnCON0bits.SIRQEN = 0;
+    }
+    return true;
+}
+
+// BFRE follows the Stop by the BFRET time, so the Stop interrupt sees the bus still held
+static void stopComplete(void) {
+    I2C1CON1bits.P = 0;
+    I2C1PIRbits.PCIF = 1;
+    sclAdvance(1);
+    state = BUS_FREE_WAIT;
+    interruptsService();
+}
+
+static void countReached(void) {
+    I2C1PIRbits.CNTIF = 1;
+    if (I2C1CON0bits.RSEN) {
+        state = BUS_WAIT_RESTART;
+        interruptsService();
+    } else {
+        interruptsService();
+        stopComplete(); // Auto stop
+    }
+}
+
+static void startCondition(void) {
+    uint8_t address = I2C1ADB1;
+
+    I2C1CON0bits.S = 0;
+    I2C1STAT0bits.BFRE = 0;
+    sclAdvance(1);
+    if (state == BUS_WAIT_RESTART) {
+        I2C1PIRbits.RSCIF = 1;
+        interruptsService();
+    } else {
+        I2C1PIRbits.SCIF = 1;
+    }
+    logByte(address);
+    if (!ackList[address >> 1]) {
+        I2C1CON1bits.ACKSTAT = 1;
+        I2C1STAT0bits.D = 0;
+        I2C1ERRbits.NACKIF = 1;
+        state = BUS_WAIT_STOP;
+        interruptsService();
+        return;
+    }
+    I2C1CON1bits.ACKSTAT = 0;
+    I2C1STAT0bits.D = 1;
+    dmaIndex = 0;
+    txbEmpty = true;
+    state = (address & 1) ? BUS_READ : BUS_WRITE;
+    if (countGet() == 0)
+        countReached();
+}
+
+// One byte time of the bus; false if nothing moved
+static bool step(void) {
+    uint16_t count = countGet();
+
+    switch (state) {
+        case BUS_IDLE:
+        case BUS_WAIT_RESTART:
+            if (!I2C1CON0bits.S)
+                return state == BUS_IDLE;
+            startCondition();
+            return true;
+        case BUS_WRITE:
+            if (txbEmpty) {
+                PIR7bits.I2C1TXIF = 1;
+                if (!dmaService())
+                    interruptsService();
+                if (txbEmpty)
+                    return false; // Nobody fed the transmit buffer
+            }
+            logByte(I2C1TXB);
+            txbEmpty = true;
+            countSet(--count);
+            if (count == 0)
+                countReached();
+            return true;
+        case BUS_READ:
+            stats.bytes++;
+            sclAdvance(SCL_PER_BYTE);
+            I2C1RXB = 0x00;
+            PIR7bits.I2C1RXIF = 1;
+            interruptsService();
+            countSet(--count);
+            if (count == 0)
+                countReached();
+            return true;
+        case BUS_WAIT_STOP:
+            if (!I2C1CON1bits.P)
+                return false;
+            stopComplete();
+            return true;
+        case BUS_FREE_WAIT:
+            clockAdvance(8U << I2C1CON2bits.BFRET); // A Start set meanwhile is held until BFRE
+            I2C1STAT0bits.BFRE = 1;
+            state = BUS_IDLE;
+            return true;
+    }
+    return false;
+}
+
+void I2C1_Regs_Sim_Reset(void) {
+    memset((void *) &I2C1CON0bits, 0, sizeof (I2C1CON0bits));
+    I2C1CON1 = I2C1CON2 = I2C1PIR = I2C1PIE = I2C1ERR = I2C1STAT1 = 0;
+    PIE7bits.value = PIR7bits.value = 0;
+    INTCON0 = DMAnCON0 = PRLOCK = 0;
+    I2C1STAT0 = 0;
+    I2C1STAT0bits.BFRE = 1;
+    I2C1CNTL = I2C1CNTH = I2C1TXB = I2C1RXB = I2C1ADB1 = 0;
+    DMAnCON1 = DMAnSIRQ = DMAnAIRQ = DMAnDSZ = 0;
+    DMAnSSA = 0;
+    DMAnSSZ = DMAnDSA = 0;
+    T1CON = T1GCON = T1GATE = T1CLK = TMR1H = TMR1L = 0;
+    tmr1Cycles = 0;
+    memset(ackList, 0, sizeof (ackList));
+    memset(&stats, 0, sizeof (stats));
+    busLogLength = 0;
+    state = BUS_IDLE;
+}
+
+void I2C1_Regs_Sim_VectoredSet(bool vectoredDispatch) {
+    vectored = vectoredDispatch;
+}
+
+void I2C1_Regs_Sim_AckSet(uint8_t address, bool ack) {
+    ackList[address & 0x7F] = ack;
+}
+
+bool I2C1_Regs_Sim_Run(void) {
+    while (state != BUS_IDLE || I2C1CON0bits.S) {
+        if (!step())
+            return false;
+    }
+    return true;
+}
+
+uint32_t I2C1_Regs_Sim_SclFrequency(void) {
+    uint32_t source;
+
+    switch (I2C1CLK) {
+        case 0x0: source = _XTAL_FREQ / 4; break;
+        case 0x1: source = _XTAL_FREQ; break;
+        default: return 0;
+    }
+    return source / ((I2C1BAUD + 1U) * (I2C1CON2bits.FME ? 4U : 5U));
+}
+
+const i2c1_regs_sim_stats_t *I2C1_Regs_Sim_StatsGet(void) {
+    return &stats;
+}
+
+const uint8_t *I2C1_Regs_Sim_BusLog(size_t *length) {
+    *length = busLogLength;
+    return busLog;
+}
@@ -0,0 +1,108 @@
+/**
+ * PIC18 I2C1 Register Model Header File
+ *
+ * @file i2c1_regs_sim.h
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Register-level model of the I2C1 host peripheral and of DMA1, for
+ *        running the unmodified mcc_generated_files I2C1 driver on a desktop
+ *        machine. The model raises the same flags as the silicon and enters
+ *        the driver's ISRs through a copy of INTERRUPT_InterruptManager's
+ *        dispatch chain, or straight through as the vector table would, so
+ *        interrupt entries and dispatch work can be counted per transfer.
+ *
+ *        Host build: gcc -Ihost -I. -DHOST_SFR_MODEL
+ *            mcc_generated_files/i2c_host/src/i2c1.c
+ *            mcc_generated_files/timer/src/tmr1.c host/i2c1_regs_sim.c prog.c
+ *        Add -DI2C1_DMA_TX=1 for the DMA transmit path. host/Makefile builds
+ *        each of its register model programs both ways.
+ */
+
+#ifndef I2C1_REGS_SIM_H
+#define I2C1_REGS_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define I2C1_REGS_SIM_LOG_SIZE 256
+
+/**
+ * @ingroup ht16k33_sim
+ * @struct i2c1_regs_sim_stats_t
+ * @brief Counters kept by the register model.
+ */
+typedef struct {
+    uint32_t interrupts; /**< Interrupt entries*/
+    uint32_t dispatchTests; /**< Enable/flag pairs the polled manager tested to find the sources*/
+    uint32_t txInterrupts; /**< I2C1_TX_ISR calls*/
+    uint32_t rxInterrupts; /**< I2C1_RX_ISR calls*/
+    uint32_t eventInterrupts; /**< I2C1_ISR calls*/
+    uint32_t errorInterrupts; /**< I2C1_ERROR_ISR calls*/
+    uint32_t dmaTransfers; /**< Bytes moved into I2C1TXB by DMA1*/
+    uint32_t bytes; /**< Address and data bytes on the bus*/
+    uint32_t sclPeriods; /**< SCL periods used, counting Start and Stop as one each*/
+} i2c1_regs_sim_stats_t;
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Idles the bus, clears every modelled register, the counters, the log
+ *        and the list of targets that acknowledge.
+ * @return void
+ */
+void I2C1_Regs_Sim_Reset(void);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Sets whether a 7-bit address acknowledges.
+ * @param [in] address - Target address.
+ * @param [in] ack - true to acknowledge.
+ * @return void
+ */
+void I2C1_Regs_Sim_AckSet(uint8_t address, bool ack);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Selects how interrupts reach the ISRs: false for the polled
+ *        INTERRUPT_InterruptManager chain (the default), true for the
+ *        multi-vector table of an INTERRUPT_VECTORED build.
+ * @param [in] vectored - Dispatch mode.
+ * @return void
+ */
+void I2C1_Regs_Sim_VectoredSet(bool vectored);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Runs the peripheral until the bus is idle again, entering the
+ *        driver's ISRs as flags are raised. BFRE sets the BFRET time after
+ *        each Stop, so transfers started from the Stop interrupt run too.
+ * @retval true - Bus went idle and BFRE is set.
+ * @retval false - The transfer stalled: no interrupt or DMA serviced a flag.
+ */
+bool I2C1_Regs_Sim_Run(void);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Returns the SCL frequency set by I2C1CLK, I2C1BAUD and FME, taking
+ *        Fosc as _XTAL_FREQ. Bus time is sclPeriods divided by this.
+ * @return SCL frequency in Hz, or 0 for a clock source the model lacks.
+ */
+uint32_t I2C1_Regs_Sim_SclFrequency(void);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Returns the model's counters.
+ * @return Pointer to the counters.
+ */
+const i2c1_regs_sim_stats_t *I2C1_Regs_Sim_StatsGet(void);
+
+/**
+ * @ingroup ht16k33_sim
+ * @brief Returns every byte put on SDA since the last reset, addresses included.
+ * @param [out] length - Number of bytes logged.
+ * @return Pointer to the log.
+ */
+const uint8_t *I2C1_Regs_Sim_BusLog(size_t *length);
+
+#endif /* I2C1_REGS_SIM_H */
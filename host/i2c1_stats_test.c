@@ -0,0 +1,99 @@
+/**
+ * I2C1 Statistics Test
+ *
+ * @file i2c1_stats_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Runs a known sequence on the register model: a display frame, a
+ *        key RAM write-read, a read, a write to an address nobody answers, an
+ *        address probe and a write refused while another is open. The counters
+ *        I2C1_StatsGet() returns afterwards must add up to exactly that
+ *        sequence, and I2C1_StatsClear() must zero them.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <xc.h>
+#include "i2c1_regs_sim.h"
+#include "mcc_generated_files/i2c_host/i2c1.h"
+#include "mcc_generated_files/timer/tmr1.h"
+
+#define PRESENT 0x70
+#define ABSENT 0x71
+
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+// Bucket the latest transfer landed in, from the bucket that grew
+static int bucketAdded(const i2c_host_stats_t *before, const i2c_host_stats_t *after) {
+    for (int i = 0; i < I2C_HOST_STATS_BUCKETS; i++)
+        if (after->latency[i] != before->latency[i])
+            return i;
+    return -1;
+}
+
+int main(void) {
+    uint8_t frame[17] = {0x00};
+    uint8_t keyPointer = 0x40;
+    uint8_t keys[6];
+    uint8_t command[] = {0x81};
+    i2c_host_stats_t stats, previous;
+    int frameBucket, probeBucket;
+    uint32_t closed = 0;
+
+    I2C1_Regs_Sim_Reset();
+    I2C1_Regs_Sim_AckSet(PRESENT, true);
+    TMR1_Initialize();
+    I2C1_Initialize();
+    I2C1_StatsClear();
+
+    // 17 data bytes, about 400 us at 100 kHz
+    I2C1_StatsGet(&previous);
+    expect(I2C1_Write(PRESENT, frame, sizeof (frame)), "frame accepted");
+    expect(!I2C1_Write(PRESENT, command, sizeof (command)), "write during the frame refused");
+    expect(I2C1_Regs_Sim_Run(), "frame completes");
+    I2C1_StatsGet(&stats);
+    frameBucket = bucketAdded(&previous, &stats);
+
+    // 1 + 6 data bytes
+    expect(I2C1_WriteRead(PRESENT, &keyPointer, 1, keys, sizeof (keys)) && I2C1_Regs_Sim_Run(), "write-read completes");
+    // 2 data bytes
+    expect(I2C1_Read(PRESENT, keys, 2) && I2C1_Regs_Sim_Run(), "read completes");
+    // Address NACK, no data bytes
+    expect(I2C1_Write(ABSENT, frame, 3) && I2C1_Regs_Sim_Run(), "write to absent address runs");
+    expect(I2C1_ErrorGet() == I2C_ERROR_ADDR_NACK, "write to absent address NACKed");
+    // Address byte alone, about 30 us
+    I2C1_StatsGet(&previous);
+    expect(I2C1_Write(PRESENT, NULL, 0) && I2C1_Regs_Sim_Run(), "probe completes");
+    I2C1_StatsGet(&stats);
+    probeBucket = bucketAdded(&previous, &stats);
+
+    for (int i = 0; i < I2C_HOST_STATS_BUCKETS; i++)
+        closed += stats.latency[i];
+    expect(stats.started == 5, "started counts every accepted transfer");
+    expect(stats.completed == 4, "completed leaves out the NACKed write");
+    expect(stats.rejectedBusy == 1, "rejectedBusy counts the refused write");
+    expect(stats.addrNacks == 1, "addrNacks counts the absent address");
+    expect(stats.dataNacks == 0 && stats.busCollisions == 0 && stats.timeouts == 0, "no other errors");
+    expect(stats.bytes == sizeof (frame) + 1 + sizeof (keys) + 2, "bytes counts data bytes only");
+    expect(closed == 5, "latency holds every closed transfer");
+    expect(probeBucket == 0, "probe in the first latency bucket");
+    expect(frameBucket > probeBucket, "frame in a later latency bucket than the probe");
+
+    I2C1_StatsClear();
+    I2C1_StatsGet(&stats);
+    memset(&previous, 0, sizeof (previous));
+    expect(memcmp(&stats, &previous, sizeof (stats)) == 0, "clear zeroes every counter");
+
+    printf("%s statistics: %s\n", I2C1_DMA_TX ? "DMA transmit" : "interrupt transmit", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
@@ -0,0 +1,63 @@
+/**
+ * I2C1 Trace Recorder
+ *
+ * @file i2c1_trace_dump.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Runs a fixed sequence through the I2C1 driver built with
+ *        I2C1_TRACE on the register model and prints the trace ring as hex
+ *        text, the way a serial console would dump I2C1_TraceCopy(). The
+ *        sequence is a display write, a key RAM write-read, a write to an
+ *        address nobody answers and a write started from the completion
+ *        callback of the one before it. i2c_trace_sample.hex is its output
+ *        and i2c_trace_sample.txt the timeline i2c_trace_decode makes of it;
+ *        make -C host check compares both.
+ *
+ *        Build: make -C host
+ */
+
+#include <stdio.h>
+#include <xc.h>
+#include "i2c1_regs_sim.h"
+#include "mcc_generated_files/i2c_host/i2c1.h"
+#include "mcc_generated_files/timer/tmr1.h"
+
+#define PRESENT 0x70
+#define ABSENT 0x71
+
+static uint8_t chained[] = {0x81}; // Display on, no blink
+
+static void startChained(i2c_host_error_t error, void *context) {
+    (void) error;
+    (void) context;
+    I2C1_Write(PRESENT, chained, sizeof (chained));
+}
+
+int main(void) {
+    static i2c_host_trace_event_t events[I2C1_TRACE_SIZE];
+    uint8_t frame[] = {0x00, 0x3F, 0x06};
+    uint8_t keyPointer = 0x40;
+    uint8_t keys[2];
+    uint8_t oscillator = 0x21;
+    const uint8_t *bytes = (const uint8_t *) events;
+
+    I2C1_Regs_Sim_Reset();
+    I2C1_Regs_Sim_AckSet(PRESENT, true);
+    TMR1_Initialize();
+    I2C1_Initialize();
+    I2C1_TraceClear();
+
+    if (!I2C1_Write(PRESENT, frame, sizeof (frame)) || !I2C1_Regs_Sim_Run() ||
+            !I2C1_WriteRead(PRESENT, &keyPointer, 1, keys, sizeof (keys)) || !I2C1_Regs_Sim_Run() ||
+            !I2C1_Write(ABSENT, frame, sizeof (frame)) || !I2C1_Regs_Sim_Run() ||
+            !I2C1_Transfer(PRESENT, &oscillator, 1, NULL, 0, startChained, NULL) || !I2C1_Regs_Sim_Run()) {
+        fprintf(stderr, "sequence did not complete\n");
+        return 1;
+    }
+
+    I2C1_TraceCopy(events);
+    for (size_t i = 0; i < sizeof (events); i++)
+        printf("%02X%s", bytes[i], (i + 1) % 16 ? " " : "\n");
+    return 0;
+}
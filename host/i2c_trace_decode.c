@@ -0,0 +1,173 @@
+/**
+ * I2C Trace Decoder
+ *
+ * @file i2c_trace_decode.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Desktop tool that turns a trace ring copied with I2C1_TraceCopy()
+ *        into a timeline. The dump is the I2C1_TRACE_SIZE entries as raw
+ *        bytes, oldest first, either binary or as hex text (-x) the way a
+ *        serial console prints them.
+ *
+ *        Build: make -C host, or gcc -I. -o i2c_trace_decode host/i2c_trace_decode.c
+ *        Usage: i2c_trace_decode [-x] [-f timer_hz] dump
+ *
+ *        Timestamps are 16-bit, so a gap of a full timer wrap or more
+ *        between two events (52 ms for TMR1 at 40 MHz) cannot be seen.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "mcc_generated_files/i2c_host/i2c_host_event_types.h"
+#include "mcc_generated_files/timer/tmr1.h"
+
+#define ENTRY_SIZE 4 // timeLow, timeHigh, code, data
+#define MAX_ENTRIES 256
+
+static const char *const errorNames[] = {"ok", "address NACK", "data NACK", "bus collision"};
+
+static size_t readBinary(FILE *in, uint8_t *bytes, size_t size) {
+    return fread(bytes, 1, size, in);
+}
+
+static int hexDigit(int c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+// Pairs of hex digits; spaces, commas, line breaks and 0x prefixes are skipped
+static size_t readHex(FILE *in, uint8_t *bytes, size_t size) {
+    size_t length = 0;
+    int high = -1;
+    int previous = 0;
+    int c;
+
+    while (length < size && (c = fgetc(in)) != EOF) {
+        int digit = hexDigit(c);
+
+        if ((c == 'x' || c == 'X') && previous == '0' && high == 0) {
+            high = -1;
+        } else if (digit < 0) {
+            high = -1;
+        } else if (high < 0) {
+            high = digit;
+        } else {
+            bytes[length++] = (uint8_t) (high << 4 | digit);
+            high = -1;
+        }
+        previous = c;
+    }
+    return length;
+}
+
+static void describe(uint8_t code, uint8_t data, char *text, size_t size) {
+    switch (code) {
+        case I2C_TRACE_START:
+            snprintf(text, size, data ? "repeated START" : "START");
+            break;
+        case I2C_TRACE_ADDRESS:
+            snprintf(text, size, "address 0x%02X (0x%02X %s)", data, data >> 1, (data & 1) ? "read" : "write");
+            break;
+        case I2C_TRACE_TX:
+            snprintf(text, size, "tx 0x%02X", data);
+            break;
+        case I2C_TRACE_RX:
+            snprintf(text, size, "rx 0x%02X", data);
+            break;
+        case I2C_TRACE_NACK:
+            snprintf(text, size, data ? "NACK on data" : "NACK on address");
+            break;
+        case I2C_TRACE_COLLISION:
+            snprintf(text, size, "bus collision");
+            break;
+        case I2C_TRACE_TIMEOUT:
+            snprintf(text, size, "bus time-out");
+            break;
+        case I2C_TRACE_STOP:
+            snprintf(text, size, data ? "STOP complete" : "STOP requested");
+            break;
+        case I2C_TRACE_CLOSE:
+            snprintf(text, size, "close, %s", data < sizeof (errorNames) / sizeof (errorNames[0]) ? errorNames[data] : "unknown error");
+            break;
+        default:
+            snprintf(text, size, "unknown event %u, data 0x%02X", code, data);
+            break;
+    }
+}
+
+int main(int argc, char **argv) {
+    static uint8_t bytes[MAX_ENTRIES * ENTRY_SIZE];
+    unsigned long timerHz = TMR1_FREQUENCY;
+    bool hex = false;
+    const char *path = NULL;
+    FILE *in;
+    size_t length;
+    uint64_t now = 0; // Unwrapped timer counts since the first event
+    uint64_t transferStart = 0;
+    uint16_t last = 0;
+    bool first = true;
+    bool open = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-x") == 0)
+            hex = true;
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+            timerHz = strtoul(argv[++i], NULL, 0);
+        else
+            path = argv[i];
+    }
+    if (path == NULL || timerHz == 0) {
+        fprintf(stderr, "usage: %s [-x] [-f timer_hz] dump\n", argv[0]);
+        return 2;
+    }
+    in = strcmp(path, "-") == 0 ? stdin : fopen(path, hex ? "r" : "rb");
+    if (in == NULL) {
+        perror(path);
+        return 1;
+    }
+    length = hex ? readHex(in, bytes, sizeof (bytes)) : readBinary(in, bytes, sizeof (bytes));
+    if (in != stdin)
+        fclose(in);
+    if (length % ENTRY_SIZE)
+        fprintf(stderr, "%s: %zu trailing bytes ignored\n", path, length % ENTRY_SIZE);
+
+    printf("%12s %10s  event\n", "time us", "delta us");
+    for (size_t i = 0; i + ENTRY_SIZE <= length; i += ENTRY_SIZE) {
+        uint16_t time = (uint16_t) (bytes[i] | bytes[i + 1] << 8);
+        uint8_t code = bytes[i + 2];
+        uint8_t data = bytes[i + 3];
+        uint16_t delta;
+        char text[64];
+
+        if (code == I2C_TRACE_EMPTY)
+            continue;
+        delta = first ? 0 : (uint16_t) (time - last);
+        now += delta;
+        last = time;
+        first = false;
+
+        if (code == I2C_TRACE_START && !data) {
+            printf("\n");
+            transferStart = now;
+            open = true;
+        }
+        describe(code, data, text, sizeof (text));
+        printf("%12.1f %10.1f  %s", now * 1e6 / timerHz, delta * 1e6 / timerHz, text);
+        if (code == I2C_TRACE_CLOSE && open) {
+            printf(" after %.1f us", (now - transferStart) * 1e6 / timerHz);
+            open = false;
+        }
+        printf("\n");
+    }
+    return 0;
+}
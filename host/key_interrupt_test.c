@@ -0,0 +1,113 @@
+/**
+ * Key Interrupt Test
+ *
+ * @file key_interrupt_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Runs the keyscan in interrupt mode against a simulated HT16K33
+ *        whose ROW15/INT level is given by HT16K33_Sim_IntAsserted(). The
+ *        test's stand-in for the INT0 handler calls Alpha_KeyInterrupt() on
+ *        the falling edge. Key RAM must not be read while the line is idle,
+ *        and a press must wake the scan and be reported.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+#include "tick.h"
+
+#define ADDRESS 0x70
+#define TICKS_PER_POLL 5
+#define IDLE_TICKS 200
+
+static alpha_context_t display;
+static ht16k33_sim_device_t *dev;
+static bool intLevel;
+static int interrupts;
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+// INT0 on the falling edge of the active low INT line
+static void intPinSample(void) {
+    bool asserted = HT16K33_Sim_IntAsserted(ADDRESS);
+
+    if (asserted && !intLevel) {
+        interrupts++;
+        Alpha_KeyInterrupt(&display);
+    }
+    intLevel = asserted;
+}
+
+static void run(uint16_t ticks) {
+    while (ticks-- > 0) {
+        TMR0_Host_Advance(1);
+        intPinSample();
+        HT16K33_Sim_Host.Tasks();
+        Alpha_Tasks(&display);
+    }
+}
+
+static bool nextEvent(uint8_t key, bool pressed) {
+    alpha_key_event_t event;
+
+    return Alpha_KeyEventGet(&display, &event) && event.key == key && event.pressed == pressed;
+}
+
+int main(void) {
+    const uint8_t address = ADDRESS;
+    uint32_t reads;
+
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_AsyncSet(true);
+    HT16K33_Sim_Attach(address);
+    dev = HT16K33_Sim_DeviceGet(address);
+    TMR0_Initialize();
+    Tick_Initialize();
+    Alpha_BeginAsync(&display, &HT16K33_Sim_Host, &address, 1, NULL);
+    run(60);
+    expect(Alpha_IsReady(&display), "bring up");
+
+    expect(Alpha_KeyscanInterruptStart(&display, 0, TICKS_PER_POLL), "keyscan started");
+    run(ALPHA_KEY_DEBOUNCE * TICKS_PER_POLL + 2);
+    expect(dev->intOutput && !dev->intActiveHigh, "ROW15 made an active low INT output");
+    expect(dev->keyReads > 0, "read once at start, a key may already be down");
+
+    // Idle line: no traffic at all
+    HT16K33_Sim_StatsClear();
+    run(IDLE_TICKS);
+    expect(dev->keyReads == 0 && HT16K33_Sim_StatsGet()->transactions == 0 && interrupts == 0, "idle: no polling");
+
+    // Press: INT asserts, the scan wakes and reports it
+    dev->keyRAM[0] = 0x04; // K1, row 2
+    run(1);
+    expect(interrupts == 1, "press: INT asserted");
+    run(ALPHA_KEY_DEBOUNCE * TICKS_PER_POLL + 2);
+    expect(nextEvent(2, true), "press: key 2 reported");
+    expect(dev->keyReads >= ALPHA_KEY_DEBOUNCE, "press: polled while the key is down");
+
+    // Held: polling goes on until the release is debounced
+    reads = dev->keyReads;
+    run(4 * TICKS_PER_POLL);
+    expect(dev->keyReads - reads == 4, "held: polled every period");
+    dev->keyRAM[0] = 0;
+    run(ALPHA_KEY_DEBOUNCE * TICKS_PER_POLL + 2);
+    expect(nextEvent(2, false), "release: key 2 reported");
+    expect(!HT16K33_Sim_IntAsserted(ADDRESS), "release: INT idle again");
+
+    // Idle again
+    reads = dev->keyReads;
+    run(IDLE_TICKS);
+    expect(dev->keyReads == reads && interrupts == 1, "idle again: polling stopped");
+
+    printf("key interrupt: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
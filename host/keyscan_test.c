@@ -0,0 +1,122 @@
+/**
+ * Keyscan Test
+ *
+ * @file keyscan_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Presses keys in the key data RAM of a simulated HT16K33 and checks
+ *        the events Alpha_KeyscanTick() reports: a change is only taken
+ *        after ALPHA_KEY_DEBOUNCE polls that agree, a bounce shorter than
+ *        that is ignored, and events past the ring's size are counted as
+ *        overflows rather than overwriting older ones.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+#include "tick.h"
+
+#define ADDRESS 0x70
+#define TICKS_PER_POLL 5
+
+static alpha_context_t display;
+static ht16k33_sim_device_t *dev;
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void run(uint16_t ticks) {
+    while (ticks-- > 0) {
+        TMR0_Host_Advance(1);
+        HT16K33_Sim_Host.Tasks();
+        Alpha_Tasks(&display);
+    }
+}
+
+// One poll: the read goes out and its result is debounced
+static void poll(uint8_t polls) {
+    run(polls * TICKS_PER_POLL);
+}
+
+// Key number as the library counts it, pressed or released in the sim's key RAM
+static void keySet(uint8_t key, bool down) {
+    uint8_t column = key / ALPHA_KEY_ROWS;
+    uint16_t mask = (uint16_t) (1U << (key % ALPHA_KEY_ROWS));
+    uint16_t row = (uint16_t) (dev->keyRAM[2 * column] | dev->keyRAM[2 * column + 1] << 8);
+
+    row = down ? row | mask : row & ~mask;
+    dev->keyRAM[2 * column] = (uint8_t) row;
+    dev->keyRAM[2 * column + 1] = (uint8_t) (row >> 8);
+}
+
+static bool nextEvent(uint8_t key, bool pressed) {
+    alpha_key_event_t event;
+
+    return Alpha_KeyEventGet(&display, &event) && event.key == key && event.pressed == pressed;
+}
+
+int main(void) {
+    const uint8_t address = ADDRESS;
+    alpha_key_event_t event;
+    uint32_t reads;
+    bool inOrder = true;
+
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_AsyncSet(true);
+    HT16K33_Sim_Attach(address);
+    dev = HT16K33_Sim_DeviceGet(address);
+    TMR0_Initialize();
+    Tick_Initialize();
+    Alpha_BeginAsync(&display, &HT16K33_Sim_Host, &address, 1, NULL);
+    run(60);
+    expect(Alpha_IsReady(&display), "bring up");
+    expect(Alpha_KeyscanStart(&display, 0, TICKS_PER_POLL), "keyscan started");
+    run(1); // Line each poll() up with one read and its result
+
+    reads = dev->keyReads;
+    poll(4);
+    expect(dev->keyReads - reads == 4, "one key RAM read per period");
+    expect(!Alpha_KeyEventGet(&display, &event), "no keys, no events");
+
+    // Press: reported once the polls agree
+    keySet(16, true);
+    poll(ALPHA_KEY_DEBOUNCE - 1);
+    expect(!Alpha_KeyEventGet(&display, &event), "press: held back until debounced");
+    poll(1);
+    expect(nextEvent(16, true), "press: key 16 reported");
+    poll(3);
+    expect(!Alpha_KeyEventGet(&display, &event), "press: reported once while held");
+
+    // Bounce: down for one poll only
+    keySet(0, true);
+    poll(1);
+    keySet(0, false);
+    poll(ALPHA_KEY_DEBOUNCE + 1);
+    expect(!Alpha_KeyEventGet(&display, &event), "bounce: ignored");
+
+    // Release
+    keySet(16, false);
+    poll(ALPHA_KEY_DEBOUNCE);
+    expect(nextEvent(16, false), "release: key 16 reported");
+
+    // Every key of K1 and K2 at once: more events than the ring holds
+    for (uint8_t key = 0; key < 2 * ALPHA_KEY_ROWS; key++)
+        keySet(key, true);
+    poll(ALPHA_KEY_DEBOUNCE);
+    for (uint8_t key = 0; key < ALPHA_KEY_EVENTS; key++)
+        inOrder &= nextEvent(key, true);
+    expect(inOrder, "overflow: the oldest events kept in order");
+    expect(!Alpha_KeyEventGet(&display, &event), "overflow: ring held ALPHA_KEY_EVENTS");
+    expect(display.keyOverflows == 2 * ALPHA_KEY_ROWS - ALPHA_KEY_EVENTS, "overflow: dropped events counted");
+
+    printf("keyscan: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
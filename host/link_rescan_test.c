@@ -0,0 +1,89 @@
+/**
+ * Link Rescan Test
+ *
+ * @file link_rescan_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Moves a display to another address on the simulated bus and checks
+ *        that Alpha_LinkTick() finds it there, and that a device in
+ *        0x70-0x77 that is not an HT16K33 is never taken for it.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+#include "tick.h"
+
+#define RUN_TICKS 400
+
+static alpha_context_t display;
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void run(uint16_t ticks) {
+    while (ticks-- > 0) {
+        TMR0_Host_Advance(1);
+        HT16K33_Sim_Host.Tasks();
+        Alpha_Tasks(&display);
+    }
+}
+
+// Display RAM of the simulated device at address matches the frame of display 0
+static bool showing(uint16_t address) {
+    const ht16k33_sim_device_t *dev = HT16K33_Sim_DeviceGet(address);
+
+    return dev->attached && !dev->foreign && memcmp(dev->displayRAM, display.displayRAM, sizeof (dev->displayRAM)) == 0;
+}
+
+static void begin(void) {
+    const uint8_t address = 0x70;
+
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_AsyncSet(true);
+    HT16K33_Sim_Attach(address);
+    TMR0_Initialize();
+    Tick_Initialize();
+    Alpha_BeginAsync(&display, &HT16K33_Sim_Host, &address, 1, NULL);
+    run(60);
+    expect(Alpha_IsReady(&display), "bring up");
+}
+
+int main(void) {
+    // The display moves to 0x73
+    begin();
+    HT16K33_Sim_Move(0x70, 0x73);
+    Alpha_Write(&display, "MOVE", 4);
+    run(RUN_TICKS);
+    expect(display.linkState[0] == ALPHA_LINK_UP && display.displayAddress[0] == 0x73, "moved: rebound to 0x73");
+    expect(showing(0x73), "moved: frame replayed at 0x73");
+
+    // A switch at 0x71 answers first in the scan, the display is at 0x74
+    begin();
+    HT16K33_Sim_AttachForeign(0x71);
+    HT16K33_Sim_Move(0x70, 0x74);
+    Alpha_Write(&display, "SKIP", 4);
+    run(RUN_TICKS);
+    expect(display.linkState[0] == ALPHA_LINK_UP && display.displayAddress[0] == 0x74, "switch: rebound past it to 0x74");
+    expect(showing(0x74), "switch: frame replayed at 0x74");
+    expect(HT16K33_Sim_DeviceGet(0x71)->foreignRegister == 0x40, "switch: only the key RAM pointer written to it");
+
+    // The display is gone and only the switch answers
+    begin();
+    HT16K33_Sim_AttachForeign(0x71);
+    HT16K33_Sim_Detach(0x70);
+    Alpha_Write(&display, "GONE", 4);
+    run(RUN_TICKS);
+    expect(display.linkState[0] == ALPHA_LINK_DOWN && display.displayAddress[0] == 0x70, "gone: link down, switch not adopted");
+
+    printf("link rescan: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
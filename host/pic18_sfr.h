@@ -0,0 +1,82 @@
+/**
+ * Host build stand-in for the PIC18-Q84 special function registers
+ *
+ * @file pic18_sfr.h
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief The registers used by the I2C1 driver, DMA1, TMR1 and the
+ *        system arbiter, as plain variables with XC8's names and bit layouts.
+ *        Included by xc.h only when HOST_SFR_MODEL is defined; the model
+ *        that gives them behaviour is host/i2c1_regs_sim.c.
+ */
+
+#ifndef HOST_PIC18_SFR_H
+#define HOST_PIC18_SFR_H
+
+#include <stdint.h>
+
+// XC8 declares both NAME and NAMEbits at one address; a union gives the same
+#define HOST_SFR(name, ...) \
+    typedef union { struct { __VA_ARGS__ }; uint8_t value; } name##bits_t; \
+    extern volatile name##bits_t name##bits
+#define HOST_SFR_BYTE(name) extern volatile uint8_t name
+
+HOST_SFR(I2C1CON0, unsigned MODE : 3; unsigned MDR : 1; unsigned CSTR : 1; unsigned S : 1; unsigned RSEN : 1; unsigned EN : 1;);
+HOST_SFR(I2C1CON1, unsigned CSD : 1; unsigned TXU : 1; unsigned RXO : 1; unsigned P : 1; unsigned ACKT : 1; unsigned ACKSTAT : 1; unsigned ACKDT : 1; unsigned ACKCNT : 1;);
+HOST_SFR(I2C1CON2, unsigned BFRET : 2; unsigned SDAHT : 2; unsigned ABD : 1; unsigned FME : 1; unsigned GCEN : 1; unsigned ACNT : 1;);
+HOST_SFR(I2C1PIR, unsigned SCIF : 1; unsigned RSCIF : 1; unsigned PCIF : 1; unsigned ADRIF : 1; unsigned WRIF : 1; unsigned : 1; unsigned ACKTIF : 1; unsigned CNTIF : 1;);
+HOST_SFR(I2C1PIE, unsigned SCIE : 1; unsigned RSCIE : 1; unsigned PCIE : 1; unsigned ADRIE : 1; unsigned WRIE : 1; unsigned : 1; unsigned ACKTIE : 1; unsigned CNTIE : 1;);
+HOST_SFR(I2C1ERR, unsigned NACKIE : 1; unsigned BCLIE : 1; unsigned BTOIE : 1; unsigned : 1; unsigned NACKIF : 1; unsigned BCLIF : 1; unsigned BTOIF : 1; unsigned : 1;);
+HOST_SFR(I2C1STAT0, unsigned : 3; unsigned D : 1; unsigned R : 1; unsigned MMA : 1; unsigned SMA : 1; unsigned BFRE : 1;);
+HOST_SFR(I2C1STAT1, unsigned RXBF : 1; unsigned : 1; unsigned CLRBF : 1; unsigned RXRE : 1; unsigned TXBE : 1; unsigned : 1; unsigned TXWE : 1; unsigned : 1;);
+HOST_SFR(PIE7, unsigned I2C1RXIE : 1; unsigned I2C1TXIE : 1; unsigned I2C1IE : 1; unsigned I2C1EIE : 1; unsigned : 4;);
+HOST_SFR(PIR7, unsigned I2C1RXIF : 1; unsigned I2C1TXIF : 1; unsigned I2C1IF : 1; unsigned I2C1EIF : 1; unsigned : 4;);
+HOST_SFR(INTCON0, unsigned INT0EDG : 1; unsigned INT1EDG : 1; unsigned INT2EDG : 1; unsigned : 2; unsigned IPEN : 1; unsigned GIEL : 1; unsigned GIE : 1;);
+HOST_SFR(DMAnCON0, unsigned XIP : 1; unsigned : 1; unsigned AIRQEN : 1; unsigned : 2; unsigned DGO : 1; unsigned SIRQEN : 1; unsigned EN : 1;);
+HOST_SFR(PRLOCK, unsigned PRLOCKED : 1; unsigned : 7;);
+HOST_SFR(T1CON, unsigned ON : 1; unsigned RD16 : 1; unsigned NOT_SYNC : 1; unsigned : 1; unsigned CKPS : 2; unsigned : 2;);
+
+#define I2C1CON0 I2C1CON0bits.value
+#define I2C1CON1 I2C1CON1bits.value
+#define I2C1CON2 I2C1CON2bits.value
+#define I2C1PIR I2C1PIRbits.value
+#define I2C1PIE I2C1PIEbits.value
+#define I2C1ERR I2C1ERRbits.value
+#define I2C1STAT0 I2C1STAT0bits.value
+#define I2C1STAT1 I2C1STAT1bits.value
+#define INTCON0 INTCON0bits.value
+#define DMAnCON0 DMAnCON0bits.value
+#define PRLOCK PRLOCKbits.value
+#define T1CON T1CONbits.value
+
+HOST_SFR_BYTE(I2C1CLK);
+HOST_SFR_BYTE(I2C1CNTL);
+HOST_SFR_BYTE(I2C1CNTH);
+HOST_SFR_BYTE(I2C1BAUD);
+HOST_SFR_BYTE(I2C1BTOC);
+HOST_SFR_BYTE(I2C1ADB1);
+HOST_SFR_BYTE(I2C1TXB);
+HOST_SFR_BYTE(I2C1RXB);
+HOST_SFR_BYTE(RB1I2C);
+HOST_SFR_BYTE(RB2I2C);
+HOST_SFR_BYTE(DMASELECT);
+HOST_SFR_BYTE(DMAnCON1);
+HOST_SFR_BYTE(DMAnSIRQ);
+HOST_SFR_BYTE(DMAnAIRQ);
+HOST_SFR_BYTE(DMAnDSZ);
+HOST_SFR_BYTE(ISRPR);
+HOST_SFR_BYTE(MAINPR);
+HOST_SFR_BYTE(DMA1PR);
+HOST_SFR_BYTE(T1GCON);
+HOST_SFR_BYTE(T1GATE);
+HOST_SFR_BYTE(T1CLK);
+HOST_SFR_BYTE(TMR1H);
+HOST_SFR_BYTE(TMR1L);
+// XC8's 24-bit integer holds a full data address; a host pointer needs more
+typedef uintptr_t __uint24;
+extern volatile __uint24 DMAnSSA;
+extern volatile uint16_t DMAnSSZ;
+extern volatile uint16_t DMAnDSA;
+
+#endif /* HOST_PIC18_SFR_H */
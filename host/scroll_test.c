@@ -0,0 +1,103 @@
+/**
+ * Scroll Test
+ *
+ * @file scroll_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Steps a marquee with the fake TMR0 clock and checks that a character
+ *        enters on the tick after Alpha_ScrollStart() and then exactly every
+ *        ticksPerStep ticks, that the text loops, and that the display shows
+ *        what Alpha_Write() would for the same four characters. Writing
+ *        stops the marquee, as does Alpha_ScrollStop().
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+#include "tick.h"
+
+#define ADDRESS 0x70
+#define REFERENCE 0x71
+#define TICKS_PER_STEP 50
+
+static const char text[] = "SCROLL";
+static alpha_context_t display;
+static alpha_context_t reference; // Rendered with Alpha_Write() for comparison
+static size_t entered;
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void run(uint16_t ticks) {
+    while (ticks-- > 0) {
+        TMR0_Host_Advance(1);
+        HT16K33_Sim_Host.Tasks();
+        Alpha_Tasks(&display);
+        Alpha_Tasks(&reference);
+    }
+}
+
+// The display and its HT16K33 show the last four characters entered
+static bool showing(size_t steps) {
+    char window[4];
+
+    for (uint8_t d = 0; d < 4; d++) {
+        size_t back = 3 - d; // Characters entered after the one in digit d
+        window[d] = steps > back ? text[(steps - 1 - back) % (sizeof (text) - 1)] : ' ';
+    }
+    Alpha_Write(&reference, window, sizeof (window));
+    return memcmp(display.displayRAM, reference.displayRAM, 16) == 0 &&
+            memcmp(HT16K33_Sim_DeviceGet(ADDRESS)->displayRAM, display.displayRAM, 16) == 0;
+}
+
+int main(void) {
+    const uint8_t address = ADDRESS;
+    const uint8_t referenceAddress = REFERENCE;
+    bool stepsOnTime = true;
+
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_Attach(ADDRESS);
+    HT16K33_Sim_Attach(REFERENCE);
+    TMR0_Initialize();
+    Tick_Initialize();
+    Alpha_BeginAsync(&display, &HT16K33_Sim_Host, &address, 1, NULL);
+    Alpha_BeginAsync(&reference, &HT16K33_Sim_Host, &referenceAddress, 1, NULL);
+    run(60);
+    expect(Alpha_IsReady(&display) && Alpha_IsReady(&reference), "bring up");
+
+    expect(Alpha_ScrollStart(&display, text, sizeof (text) - 1, TICKS_PER_STEP), "scroll started");
+    expect(showing(0), "start: blank");
+    run(1);
+    expect(showing(++entered), "first character enters on the next tick");
+
+    // Twice through the text, checking the tick before each step as well
+    for (uint8_t s = 0; s < 2 * (sizeof (text) - 1); s++) {
+        run(TICKS_PER_STEP - 1);
+        stepsOnTime &= showing(entered);
+        run(1);
+        stepsOnTime &= showing(++entered);
+    }
+    expect(stepsOnTime, "one step every TICKS_PER_STEP ticks, looping through the text");
+
+    Alpha_ScrollStop(&display);
+    run(3 * TICKS_PER_STEP);
+    expect(showing(entered), "stopped: frozen");
+
+    Alpha_ScrollStart(&display, text, sizeof (text) - 1, TICKS_PER_STEP);
+    run(1 + TICKS_PER_STEP);
+    Alpha_Write(&display, "DONE", 4);
+    Alpha_Write(&reference, "DONE", 4);
+    run(3 * TICKS_PER_STEP);
+    expect(memcmp(display.displayRAM, reference.displayRAM, 16) == 0, "write: replaces the marquee");
+
+    printf("scroll: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * Display RAM Scrub Test
+ *
+ * @file scrub_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Corrupts the display RAM of a simulated HT16K33 behind the
+ *        library's back and checks that the read back started by
+ *        Alpha_ScrubStart() finds the mismatch and rewrites only the byte
+ *        that differs, and that a display left alone is only ever read.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alphaDisplay.h"
+#include "tick.h"
+
+#define ADDRESS 0x70
+#define TICKS_PER_READ 10
+#define CORRUPT_BYTE 5
+
+static alpha_context_t display;
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void run(uint16_t ticks) {
+    while (ticks-- > 0) {
+        TMR0_Host_Advance(1);
+        HT16K33_Sim_Host.Tasks();
+        Alpha_Tasks(&display);
+    }
+}
+
+int main(void) {
+    const uint8_t address = ADDRESS;
+    ht16k33_sim_device_t *dev;
+
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_AsyncSet(true);
+    HT16K33_Sim_Attach(address);
+    TMR0_Initialize();
+    Tick_Initialize();
+    Alpha_BeginAsync(&display, &HT16K33_Sim_Host, &address, 1, NULL);
+    run(60);
+    expect(Alpha_IsReady(&display), "bring up");
+    Alpha_Write(&display, "SCRB", 4);
+    run(5);
+    dev = HT16K33_Sim_DeviceGet(address);
+    expect(memcmp(dev->displayRAM, display.displayRAM, 16) == 0, "frame sent");
+
+    // Intact RAM: read back, nothing written
+    HT16K33_Sim_StatsClear();
+    Alpha_ScrubStart(&display, TICKS_PER_READ);
+    run(3 * TICKS_PER_READ + 2);
+    expect(HT16K33_Sim_StatsGet()->transactions == 3, "intact: one read back per period");
+    expect(dev->ramWrites == 0 && display.scrubRepairs == 0, "intact: nothing rewritten");
+
+    // A byte flipped on the device, as by a brown-out or a glitch on SDA
+    HT16K33_Sim_StatsClear();
+    dev->displayRAM[CORRUPT_BYTE] ^= 0xFF;
+    run(TICKS_PER_READ + 2);
+    expect(display.scrubRepairs == 1, "corrupt: mismatch found");
+    expect(dev->ramWrites == 1 && dev->ramBytesWritten == 1, "corrupt: only the differing byte rewritten");
+    expect(memcmp(dev->displayRAM, display.displayRAM, 16) == 0, "corrupt: device RAM matches the context again");
+
+    // Repaired, so the next read back finds nothing
+    run(TICKS_PER_READ);
+    expect(display.scrubRepairs == 1 && dev->ramWrites == 1, "repaired: next read back matches");
+
+    Alpha_ScrubStop(&display);
+    HT16K33_Sim_StatsClear();
+    run(3 * TICKS_PER_READ);
+    expect(HT16K33_Sim_StatsGet()->transactions == 0, "stopped: no more reads");
+
+    printf("scrub: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * Non-blocking Bring Up Test
+ *
+ * @file startup_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Brings a chain of two displays up with Alpha_BeginAsync() on the
+ *        asynchronous simulated bus, one fake TMR0 tick at a time, and
+ *        records the tick each kind of command first reaches each HT16K33.
+ *        Checks that Alpha_BeginAsync() returns without waiting, that
+ *        nothing is sent during the 20 ms power up, that dimming follows the
+ *        oscillator start by at least 10 ms, that the commands arrive in
+ *        bring up order and that the ready callback runs once, after the
+ *        blank frame reached every display.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include "alphaDisplay.h"
+#include "tick.h"
+
+#define POWER_UP_MS 20 // HT16K33 datasheet
+#define OSCILLATOR_MS 10
+#define TIMEOUT_TICKS 100
+
+typedef struct {
+    uint16_t systemSetup;
+    uint16_t dimming;
+    uint16_t displaySetup;
+    uint16_t ram;
+} arrival_t; // Tick a command kind first reached the device, 0 if not yet
+
+static const uint8_t addresses[] = {0x70, 0x71};
+static alpha_context_t display;
+static arrival_t arrival[sizeof (addresses)];
+static uint16_t readyTick;
+static int readyCalls;
+static uint16_t tick;
+static int failures;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void onReady(alpha_context_t *ready) {
+    expect(ready == &display, "ready: called with the context");
+    readyCalls++;
+    readyTick = tick;
+}
+
+static void record(uint16_t *at, uint32_t count) {
+    if (*at == 0 && count > 0)
+        *at = tick;
+}
+
+int main(void) {
+    uint64_t before;
+    bool ordered = true;
+
+    HT16K33_Sim_Reset();
+    HT16K33_Sim_AsyncSet(true);
+    for (uint8_t i = 0; i < sizeof (addresses); i++)
+        HT16K33_Sim_Attach(addresses[i]);
+    TMR0_Initialize();
+    Tick_Initialize();
+
+    before = HT16K33_Sim_TimeGet();
+    expect(Alpha_BeginAsync(&display, &HT16K33_Sim_Host, addresses, sizeof (addresses), onReady), "begin accepted");
+    expect(HT16K33_Sim_TimeGet() == before && HT16K33_Sim_StatsGet()->transactions == 0, "begin: returns without waiting or sending");
+    expect(!Alpha_IsReady(&display), "begin: not ready yet");
+
+    for (tick = 1; tick <= TIMEOUT_TICKS; tick++) {
+        TMR0_Host_Advance(1);
+        HT16K33_Sim_Host.Tasks();
+        Alpha_Tasks(&display);
+        for (uint8_t i = 0; i < sizeof (addresses); i++) {
+            const ht16k33_sim_device_t *dev = HT16K33_Sim_DeviceGet(addresses[i]);
+
+            record(&arrival[i].systemSetup, dev->systemSetupWrites);
+            record(&arrival[i].dimming, dev->dimmingWrites);
+            record(&arrival[i].displaySetup, dev->displaySetupWrites);
+            record(&arrival[i].ram, dev->ramWrites);
+        }
+    }
+
+    for (uint8_t i = 0; i < sizeof (addresses); i++) {
+        const ht16k33_sim_device_t *dev = HT16K33_Sim_DeviceGet(addresses[i]);
+        const arrival_t *at = &arrival[i];
+
+        ordered &= at->systemSetup > POWER_UP_MS / ALPHA_TICK_MS;
+        ordered &= at->dimming >= at->systemSetup + OSCILLATOR_MS / ALPHA_TICK_MS;
+        ordered &= at->displaySetup > at->dimming && at->ram > at->displaySetup;
+        ordered &= readyTick >= at->ram;
+        expect(dev->oscillatorOn && dev->displayOn && dev->dimming == 15 && dev->blinkRate == 0, "device set up");
+        expect(dev->systemSetupWrites == 1 && dev->dimmingWrites == 1 && dev->displaySetupWrites == 1 && dev->ramWrites == 1,
+               "each bring up command sent once");
+    }
+    expect(ordered, "power up, oscillator, dimming, display setup, blank frame, then ready");
+    expect(readyCalls == 1 && Alpha_IsReady(&display), "ready: called once");
+    printf("bring up: oscillator at tick %u, dimming %u, display setup %u, blank frame %u, ready %u\n", arrival[0].systemSetup,
+           arrival[0].dimming, arrival[0].displaySetup, arrival[0].ram, readyTick);
+
+    printf("startup: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
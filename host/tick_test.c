@@ -0,0 +1,128 @@
+/**
+ * Tick Service Test
+ *
+ * @file tick_test.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Drives tick.c from the fake TMR0 in tmr0_host.c: the tick count,
+ *        one-shot and periodic timers, comparisons across the 32-bit wrap,
+ *        and the display ticks Alpha_Tasks() runs as time passes. The tick
+ *        itself cannot be run up to the wrap in a test, so the stored ticks
+ *        are placed just before it instead.
+ *
+ *        Build and run: make -C host check
+ */
+
+#include <stdio.h>
+#include "alphaDisplay.h"
+#include "tick.h"
+
+#define STEP_TICKS 5
+
+static alpha_context_t display;
+static int failures;
+static tick_timer_t oneShot;
+static tick_timer_t periodic;
+
+static void expect(bool condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void count(void *context) {
+    (*(int *) context)++;
+}
+
+// Scroll steps taken by one Alpha_Tasks() call after ticks of TMR0
+static size_t stepsAfter(uint32_t ticks) {
+    size_t before = display.scrollNext;
+
+    TMR0_Host_Advance(ticks);
+    Alpha_Tasks(&display);
+    return display.scrollNext - before;
+}
+
+int main(void) {
+    int oneShotRuns = 0;
+    int periodicRuns = 0;
+    const uint8_t address = 0x70;
+    static const char text[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    HT16K33_Sim_Reset();
+    TMR0_Initialize();
+    Tick_Initialize();
+    expect(Tick_Get() == 0, "tick starts at 0");
+    TMR0_Host_Advance(5);
+    expect(Tick_Get() == 5, "one tick per TMR0 period");
+    expect(Tick_Elapsed(0, 5) && !Tick_Elapsed(0, 6), "elapsed");
+
+    // One-shot
+    Tick_TimerStart(&oneShot, 3, 0, count, &oneShotRuns);
+    TMR0_Host_Advance(2);
+    Tick_Tasks();
+    expect(oneShotRuns == 0 && Tick_TimerActive(&oneShot), "one-shot: not due early");
+    TMR0_Host_Advance(1);
+    Tick_Tasks();
+    expect(oneShotRuns == 1 && !Tick_TimerActive(&oneShot), "one-shot: runs once when due");
+    TMR0_Host_Advance(10);
+    Tick_Tasks();
+    expect(oneShotRuns == 1, "one-shot: does not run again");
+
+    // Periodic, keeping its phase when Tick_Tasks() runs late
+    Tick_TimerStart(&periodic, 2, 5, count, &periodicRuns);
+    TMR0_Host_Advance(2);
+    Tick_Tasks();
+    expect(periodicRuns == 1, "periodic: first run after the delay");
+    TMR0_Host_Advance(4);
+    Tick_Tasks();
+    expect(periodicRuns == 1, "periodic: not due before the period");
+    TMR0_Host_Advance(1);
+    Tick_Tasks();
+    expect(periodicRuns == 2, "periodic: second run one period later");
+    TMR0_Host_Advance(10);
+    Tick_Tasks();
+    Tick_Tasks();
+    Tick_Tasks();
+    expect(periodicRuns == 4, "periodic: late runs caught up one per call");
+    Tick_TimerStop(&periodic);
+    TMR0_Host_Advance(10);
+    Tick_Tasks();
+    expect(periodicRuns == 4 && !Tick_TimerActive(&periodic), "periodic: stopped");
+
+    // Comparisons across the wrap
+    expect(Tick_Elapsed(0xFFFFFFF0UL, Tick_Get() + 0x10) && !Tick_Elapsed(0xFFFFFFF0UL, Tick_Get() + 0x11),
+           "wrap: elapsed counts through zero");
+    Tick_TimerStart(&oneShot, 0, 0, count, &oneShotRuns);
+    oneShot.due = 0xFFFFFFFEUL; // Fell due just before the tick wrapped
+    Tick_Tasks();
+    expect(oneShotRuns == 2, "wrap: timer due before zero runs");
+    Tick_TimerStart(&oneShot, 0, 0, count, &oneShotRuns);
+    oneShot.due = Tick_Get() + 0x7FFFFFFFUL; // Far ahead, not overdue
+    Tick_Tasks();
+    expect(oneShotRuns == 2, "wrap: timer due after zero waits");
+    Tick_TimerStop(&oneShot);
+
+    // Display ticks run by Alpha_Tasks()
+    HT16K33_Sim_Attach(address);
+    Alpha_BeginAsync(&display, &HT16K33_Sim_Host, &address, 1, NULL);
+    for (uint8_t t = 0; t < 60 && !Alpha_IsReady(&display); t++) {
+        TMR0_Host_Advance(1);
+        Alpha_Tasks(&display);
+    }
+    expect(Alpha_IsReady(&display), "bring up");
+    Alpha_ScrollStart(&display, text, sizeof (text) - 1, STEP_TICKS);
+    expect(stepsAfter(1) == 1, "Alpha_Tasks: first step on the next tick");
+    expect(stepsAfter(STEP_TICKS - 1) == 0 && stepsAfter(1) == 1, "Alpha_Tasks: one step per period");
+    expect(stepsAfter(3 * STEP_TICKS) == 3, "Alpha_Tasks: late call catches up");
+    expect(stepsAfter(10 * ALPHA_CATCH_UP_TICKS) == ALPHA_CATCH_UP_TICKS / STEP_TICKS,
+           "Alpha_Tasks: catch up capped at ALPHA_CATCH_UP_TICKS");
+    Tick_Initialize();
+    display.lastTick = (uint32_t) (0 - 2 * STEP_TICKS); // Last display tick run just before the wrap
+    expect(stepsAfter(0) == 2, "Alpha_Tasks: ticks counted across the wrap");
+
+    printf("tick: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * TMR0 Host Driver File
+ *
+ * @file tmr0_host.c
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Fake clock standing in for mcc_generated_files/timer/src/tmr0.c.
+ *        TMR0_Host_Advance() plays the role of the 1 ms overflow interrupt
+ *        and keeps the simulator clock in step with the tick.
+ */
+
+#include "../mcc_generated_files/timer/tmr0.h"
+#include "ht16k33_sim.h"
+
+static void (*TMR0_OverflowCallback)(void) = NULL;
+static bool running = false;
+
+void TMR0_Initialize(void) {
+    running = false;
+}
+
+void TMR0_Start(void) {
+    running = true;
+}
+
+void TMR0_Stop(void) {
+    running = false;
+}
+
+void TMR0_OverflowCallbackRegister(void (*CallbackHandler)(void)) {
+    TMR0_OverflowCallback = CallbackHandler;
+}
+
+void TMR0_ISR(void) {
+    if (TMR0_OverflowCallback != NULL)
+        TMR0_OverflowCallback();
+}
+
+void TMR0_Host_Advance(uint32_t milliseconds) {
+    while (milliseconds--) {
+        HT16K33_Sim_TimeAdvance(TMR0_PERIOD_MS * 1000UL);
+        if (running)
+            TMR0_ISR();
+    }
+}
@@ -0,0 +1,32 @@
+/**
+ * Host build stand-in for the XC8 device header
+ *
+ * @file xc.h
+ *
+ * @ingroup ht16k33_sim
+ *
+ * @brief Lets the library headers be compiled with a desktop compiler.
+ *        Only the compiler intrinsics referenced outside of register-level
+ *        code are provided; the SFR definitions are intentionally absent so
+ *        that any accidental register access fails to compile on the host.
+ *        Register-level drivers are built against the register model by
+ *        defining HOST_SFR_MODEL, which pulls in pic18_sfr.h.
+ */
+
+#ifndef HOST_XC_H
+#define HOST_XC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define __interrupt(...)
+#define __nop()
+#define __delay_ms(x)
+#define __delay_us(x)
+
+#ifdef HOST_SFR_MODEL
+#include "pic18_sfr.h"
+#endif
+
+#endif /* HOST_XC_H */
@@ -0,0 +1,187 @@
+/**
+ * I2C Transaction Queue Source File
+ *
+ * @file i2cQueue.c
+ *
+ * @ingroup i2c_queue
+ *
+ * @brief Ring buffers of pending writes, one per bus. The main loop only
+ *        ever appends at head; the transaction at tail is retired and its
+ *        successor started from its own completion callback in interrupt
+ *        context.
+ */
+
+#include <string.h>
+#include "i2cQueue.h"
+#include "mcc_generated_files/system/system.h"
+
+#if defined(__XC8)
+#define I2CQUEUE_CRITICAL_ENTER() uint8_t gieSave = INTERRUPT_GlobalInterruptStatus(); INTERRUPT_GlobalInterruptDisable()
+#define I2CQUEUE_CRITICAL_EXIT() INTCON0bits.GIE = gieSave
+#else
+// Host builds complete transfers from the main loop, nothing to mask
+#define I2CQUEUE_CRITICAL_ENTER()
+#define I2CQUEUE_CRITICAL_EXIT()
+#endif
+
+typedef struct {
+    uint16_t address;
+    uint8_t *buffer; // Caller-owned payload, NULL when held in bytes[]
+    uint8_t length;
+    uint8_t bytes[I2C_QUEUE_INLINE_BYTES];
+    uint8_t *readBuffer; // Read after the write when readLength is not 0
+    uint8_t readLength;
+    volatile bool *pending;
+    volatile i2c_host_error_t *error;
+} i2c_queue_entry_t;
+
+// One FIFO per bus, taken by the first request for that bus
+typedef struct {
+    const i2c_host_interface_t *host; // NULL while the lane is free
+    i2c_queue_entry_t entries[I2C_QUEUE_SIZE];
+    volatile uint8_t head; // Next free slot, written by the main loop only
+    volatile uint8_t tail; // Oldest transaction, written by the ISR only
+    volatile uint8_t count;
+    volatile bool inFlight;
+    uint8_t highWater;
+} i2c_queue_lane_t;
+
+static i2c_queue_lane_t lanes[I2C_QUEUE_BUSES];
+
+static void transferDone(i2c_host_error_t error, void *context);
+
+// Start the transaction at tail unless one is already on the bus. Runs with the I2C interrupt masked or from it.
+
+static void startNext(i2c_queue_lane_t *lane) {
+    while (lane->count > 0 && !lane->inFlight) {
+        i2c_queue_entry_t *entry = &lane->entries[lane->tail];
+        uint8_t *data = entry->buffer != NULL ? entry->buffer : entry->bytes;
+        bool started;
+
+        lane->inFlight = true; // Set first, a synchronous driver may call back from inside Transfer
+        started = lane->host->Transfer(entry->address, data, entry->length, entry->readBuffer, entry->readLength, transferDone, lane);
+        if (!started) {
+            lane->inFlight = false; // Bus held by another client, retried on its completion or from Tasks
+            return;
+        }
+    }
+}
+
+// Completion callback of the transaction at tail of the lane in context. Runs in interrupt context.
+
+static void transferDone(i2c_host_error_t error, void *context) {
+    i2c_queue_lane_t *lane = context;
+    i2c_queue_entry_t *entry = &lane->entries[lane->tail];
+
+    if (entry->error != NULL && error != I2C_ERROR_NONE)
+        *entry->error = error;
+    if (entry->pending != NULL)
+        *entry->pending = false;
+    lane->tail = (lane->tail + 1) % I2C_QUEUE_SIZE;
+    lane->count--;
+    lane->inFlight = false;
+    startNext(lane);
+}
+
+// The bus's lane, claiming a free one on first use. Runs with the I2C interrupt masked.
+
+static i2c_queue_lane_t *laneFor(const i2c_host_interface_t *host) {
+    i2c_queue_lane_t *unused = NULL;
+
+    for (uint8_t i = 0; i < I2C_QUEUE_BUSES; i++) {
+        if (lanes[i].host == host)
+            return &lanes[i];
+        if (lanes[i].host == NULL && unused == NULL)
+            unused = &lanes[i];
+    }
+    if (unused != NULL)
+        unused->host = host;
+    return unused;
+}
+
+static bool enqueue(const i2c_host_interface_t *host, uint16_t address, uint8_t *buffer, const uint8_t *bytes, uint8_t dataLength,
+        uint8_t *readBuffer, uint8_t readLength, volatile bool *pending, volatile i2c_host_error_t *error) {
+    bool retStatus = false;
+
+    I2CQUEUE_CRITICAL_ENTER();
+    i2c_queue_lane_t *lane = laneFor(host);
+    if (lane != NULL && lane->count < I2C_QUEUE_SIZE) {
+        i2c_queue_entry_t *entry = &lane->entries[lane->head];
+
+        entry->address = address;
+        entry->buffer = buffer;
+        entry->length = dataLength;
+        entry->readBuffer = readBuffer;
+        entry->readLength = readLength;
+        if (bytes != NULL)
+            memcpy(entry->bytes, bytes, dataLength);
+        entry->pending = pending;
+        if (pending != NULL)
+            *pending = true;
+        entry->error = error;
+
+        lane->head = (lane->head + 1) % I2C_QUEUE_SIZE;
+        lane->count++;
+        if (lane->count > lane->highWater)
+            lane->highWater = lane->count;
+        startNext(lane);
+        retStatus = true;
+    }
+    I2CQUEUE_CRITICAL_EXIT();
+    return retStatus;
+}
+
+void I2CQueue_Initialize(void) {
+    I2CQUEUE_CRITICAL_ENTER();
+    memset(lanes, 0, sizeof (lanes));
+    I2CQUEUE_CRITICAL_EXIT();
+}
+
+bool I2CQueue_Write(const i2c_host_interface_t *host, uint16_t address, const uint8_t *data, uint8_t dataLength) {
+    if (dataLength == 0 || dataLength > I2C_QUEUE_INLINE_BYTES)
+        return false;
+    return enqueue(host, address, NULL, data, dataLength, NULL, 0, NULL, NULL);
+}
+
+bool I2CQueue_WriteBuffer(const i2c_host_interface_t *host, uint16_t address, uint8_t *data, uint8_t dataLength, volatile bool *pending,
+        volatile i2c_host_error_t *error) {
+    return enqueue(host, address, data, NULL, dataLength, NULL, 0, pending, error);
+}
+
+bool I2CQueue_WriteRead(const i2c_host_interface_t *host, uint16_t address, uint8_t *writeData, uint8_t writeLength,
+        uint8_t *readData, uint8_t readLength, volatile bool *pending, volatile i2c_host_error_t *error) {
+    if (readLength == 0)
+        return false;
+    return enqueue(host, address, writeData, NULL, writeLength, readData, readLength, pending, error);
+}
+
+void I2CQueue_TransferDone(void) {
+    // The queue's own transfers were already retired by transferDone(); a
+    // lane left idle here found its bus held by another client
+    for (uint8_t i = 0; i < I2C_QUEUE_BUSES && lanes[i].host != NULL; i++)
+        startNext(&lanes[i]);
+}
+
+void I2CQueue_Tasks(void) {
+    I2CQUEUE_CRITICAL_ENTER();
+    for (uint8_t i = 0; i < I2C_QUEUE_BUSES && lanes[i].host != NULL; i++)
+        startNext(&lanes[i]);
+    I2CQUEUE_CRITICAL_EXIT();
+}
+
+uint8_t I2CQueue_Depth(void) {
+    uint8_t depth = 0;
+
+    for (uint8_t i = 0; i < I2C_QUEUE_BUSES; i++)
+        depth += lanes[i].count;
+    return depth;
+}
+
+uint8_t I2CQueue_HighWater(void) {
+    uint8_t highWater = 0;
+
+    for (uint8_t i = 0; i < I2C_QUEUE_BUSES; i++)
+        if (lanes[i].highWater > highWater)
+            highWater = lanes[i].highWater;
+    return highWater;
+}
@@ -0,0 +1,134 @@
+/**
+ * I2C Transaction Queue Header File
+ *
+ * @file i2cQueue.h
+ *
+ * @defgroup i2c_queue I2C_QUEUE
+ *
+ * @brief Fixed-capacity FIFO of write transactions in front of non-blocking
+ *        I2C host drivers. Requests are accepted while the bus is busy and
+ *        the next one is started from the completion callback of the one
+ *        before, so callers never spin on IsBusy() and never lose a command. Each
+ *        request names the bus it goes to. Every bus has its own FIFO, so
+ *        requests to one bus run in order while other buses run alongside.
+ *        A request may read back after its write, for register reads.
+ */
+
+#ifndef I2CQUEUE_H
+#define I2CQUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "mcc_generated_files/i2c_host/i2c_host_interface.h"
+
+// Number of transactions that can wait for the bus. Sized for a setup command
+// burst to four chained displays while the first one is still on the bus.
+#ifndef I2C_QUEUE_SIZE
+#define I2C_QUEUE_SIZE 16
+#endif
+// Buses the queue can drive at once, each with its own I2C_QUEUE_SIZE FIFO
+#ifndef I2C_QUEUE_BUSES
+#define I2C_QUEUE_BUSES 2
+#endif
+// Payloads up to this size are copied into the queue; longer ones are sent in place
+#define I2C_QUEUE_INLINE_BYTES 2
+
+/**
+ * @ingroup i2c_queue
+ * @brief Empties the queue. Drivers used with the queue must implement
+ *        Transfer(). Pointing their transfer done callback at
+ *        I2CQueue_TransferDone() as well lets the queue resume as soon as
+ *        another client releases a shared bus.
+ * @param void
+ * @return void
+ */
+void I2CQueue_Initialize(void);
+
+/**
+ * @ingroup i2c_queue
+ * @brief Queues a write of up to I2C_QUEUE_INLINE_BYTES bytes. The bytes are
+ *        copied, so data may live on the caller's stack.
+ * @param [in] host - Bus to write to.
+ * @param [in] address - 7-bit Client address.
+ * @param [in] data - bytes to write.
+ * @param [in] dataLength - number of bytes, 1 to I2C_QUEUE_INLINE_BYTES.
+ * @return true if queued, false if the bus's queue is full, every queue
+ *         already belongs to another bus, or dataLength is too long.
+ */
+bool I2CQueue_Write(const i2c_host_interface_t *host, uint16_t address, const uint8_t *data, uint8_t dataLength);
+
+/**
+ * @ingroup i2c_queue
+ * @brief Queues a write straight from the caller's buffer without copying it.
+ *        The buffer must stay unchanged until *pending reads false. A
+ *        dataLength of 0 sends the address alone, which probes the Client.
+ * @param [in] host - Bus to write to.
+ * @param [in] address - 7-bit Client address.
+ * @param [in] data - bytes to write, owned by the caller.
+ * @param [in] dataLength - number of bytes.
+ * @param [out] pending - set true now and false once the transfer has ended,
+ *                        may be NULL.
+ * @param [out] error - set to the driver's error state if the transfer
+ *                      fails, left untouched if it succeeds, may be NULL.
+ *                      Several writes may share one to latch any failure.
+ * @return true if queued, false as for I2CQueue_Write().
+ */
+bool I2CQueue_WriteBuffer(const i2c_host_interface_t *host, uint16_t address, uint8_t *data, uint8_t dataLength, volatile bool *pending,
+        volatile i2c_host_error_t *error);
+
+/**
+ * @ingroup i2c_queue
+ * @brief Queues a write followed by a read through a repeated Start. Both
+ *        buffers belong to the caller: writeData must stay unchanged and
+ *        readData must not be used until *pending reads false.
+ * @param [in] host - Bus to use.
+ * @param [in] address - 7-bit Client address.
+ * @param [in] writeData - bytes to write first, usually a register address.
+ * @param [in] writeLength - number of bytes to write.
+ * @param [out] readData - buffer for the bytes read.
+ * @param [in] readLength - number of bytes to read, at least 1.
+ * @param [out] pending - as for I2CQueue_WriteBuffer(), may be NULL.
+ * @param [out] error - as for I2CQueue_WriteBuffer(), may be NULL.
+ * @return true if queued, false as for I2CQueue_Write() or if readLength is 0.
+ */
+bool I2CQueue_WriteRead(const i2c_host_interface_t *host, uint16_t address, uint8_t *writeData, uint8_t writeLength,
+        uint8_t *readData, uint8_t readLength, volatile bool *pending, volatile i2c_host_error_t *error);
+
+/**
+ * @ingroup i2c_queue
+ * @brief Transfer done callback for the host drivers. Starts the head of
+ *        every queue that an earlier attempt found held by another client.
+ *        The queue's own transfers are retired by their completion
+ *        callbacks. Called in interrupt context.
+ * @param void
+ * @return void
+ */
+void I2CQueue_TransferDone(void);
+
+/**
+ * @ingroup i2c_queue
+ * @brief Starts the head of the queue if an earlier attempt found the bus
+ *        held by another client. Call from the main loop.
+ * @param void
+ * @return void
+ */
+void I2CQueue_Tasks(void);
+
+/**
+ * @ingroup i2c_queue
+ * @brief Number of transactions queued or in flight, all buses together.
+ * @param void
+ * @return Current queue depth.
+ */
+uint8_t I2CQueue_Depth(void);
+
+/**
+ * @ingroup i2c_queue
+ * @brief Deepest any one bus's queue has been since I2CQueue_Initialize().
+ * @param void
+ * @return Queue high-water mark.
+ */
+uint8_t I2CQueue_HighWater(void);
+
+#endif /* I2CQUEUE_H */
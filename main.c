@@ -33,6 +33,7 @@
 #include "mcc_generated_files/system/system.h"
 #include "mcc_generated_files/timer/delay.h"
 #include "alphaDisplay.h"
+#include "tick.h"
 #include <string.h>
 
 #define HT16K33_ADDRESS  0x70      //Address bits can be altered on device if wished
@@ -41,28 +42,54 @@
 #define DISPLAY_SETUP    0x81
 #define DISPLAY_MEMORY   0x00      //Start address. auto increments on every write. valid from 0x00 - 0xFF then auto wraps after last valid address
 
+static alpha_context_t display;
+static tick_timer_t countTimer;
+static int count = 100;
+
+static void countDown(void *context)
+{
+    LED_RF3_Toggle();
+    Alpha_WriteInt(&display,count-=1,false);
+}
+
+// HT16K33 ROW15/INT is wired to RB0, INT0 on its falling edge
+static void keypadInterrupt(void)
+{
+    Alpha_KeyInterrupt(&display);
+}
+
+static void displayReady(alpha_context_t *readyDisplay)
+{
+    Tick_TimerStart(&countTimer, 0, 100, countDown, NULL);
+    Alpha_KeyscanInterruptStart(readyDisplay, 0, 10);
+    INT0_SetInterruptHandler(keypadInterrupt);
+    EXT_INT0_InterruptEnable();
+}
 
 int main(void)
 {
+    const uint8_t addresses[] = {HT16K33_ADDRESS};
+    alpha_key_event_t key;
+
     SYSTEM_Initialize();
 
     // Enable the Global Interrupts 
     INTERRUPT_GlobalInterruptEnable(); 
 
-    Alpha_Begin();  
-    
-    char msg[16] = {};
-    for(int i=0;i<16;i++)
-        msg[i]=0;
-
-    int count = 100;
+    Tick_Initialize();
+    Alpha_BeginAsync(&display, &ALPHA_I2C_HOST, addresses, 1, displayReady);
 
     while(1)
     {
-        LED_RF3_Toggle();
-        DELAY_milliseconds(100);
-        sprintf(msg,"%d",count-=1);
-        Alpha_Write(msg,4);
-
+        // Nothing blocks: other work can run here between timer callbacks
+        Tick_Tasks();
+        Alpha_Tasks(&display);
+        while (Alpha_KeyEventGet(&display, &key))
+        {
+            if (key.pressed)
+            {
+                count = 100; // Any key restarts the count
+            }
+        }
     }    
 }
\ No newline at end of file
@@ -47,15 +47,80 @@
 
 #define i2c1_host_host_interface I2C1_Host
 
+/**
+ * @ingroup i2c_host
+ * @brief Set to 1 to have DMA1 feed I2C1TXB from the write buffer, so a
+ *        write costs no I2C1TX interrupts. DMA1 is then owned by this driver.
+ */
+#ifndef I2C1_DMA_TX
+#define I2C1_DMA_TX 0
+#endif
+
+/**
+ * @ingroup i2c_host
+ * @brief DMA start trigger: the I2C1TX interrupt vector number of the device.
+ */
+#ifndef I2C1_DMA_TX_TRIGGER
+#define I2C1_DMA_TX_TRIGGER 0x39
+#endif
+
+/**
+ * @ingroup i2c_host
+ * @brief RB1I2C/RB2I2C pad setting for Standard and Fast mode: I2C slew
+ *        limiting, 2x weak pull-up, I2C input thresholds.
+ */
+#ifndef I2C1_PAD_FAST
+#define I2C1_PAD_FAST 0x51
+#endif
+
+/**
+ * @ingroup i2c_host
+ * @brief RB1I2C/RB2I2C pad setting for Fast mode Plus: the 1 MHz slew rate,
+ *        2x weak pull-up, I2C input thresholds.
+ */
+#ifndef I2C1_PAD_FAST_PLUS
+#define I2C1_PAD_FAST_PLUS 0x91
+#endif
+
+/**
+ * @ingroup i2c_host
+ * @brief Set to 0 to compile out the transfer counters and the latency
+ *        histogram. Latency is timed with TMR1, which must then be running.
+ */
+#ifndef I2C1_STATS
+#define I2C1_STATS 1
+#endif
+
+/**
+ * @ingroup i2c_host
+ * @brief Set to 1 to record bus events from the I2C1 ISRs into a ring of
+ *        the last I2C1_TRACE_SIZE events, timestamped with TMR1. Transmit
+ *        bytes fed by DMA1 are not seen by the CPU and so are not recorded.
+ */
+#ifndef I2C1_TRACE
+#define I2C1_TRACE 0
+#endif
+
+/**
+ * @ingroup i2c_host
+ * @brief Trace ring length in events, a power of 2 up to 256.
+ */
+#ifndef I2C1_TRACE_SIZE
+#define I2C1_TRACE_SIZE 64
+#endif
+
 
 #define I2C1_Host_Initialize I2C1_Initialize
 #define I2C1_Host_Deinitialize I2C1_Deinitialize
 #define I2C1_Host_Write I2C1_Write
 #define I2C1_Host_Read I2C1_Read
 #define I2C1_Host_WriteRead I2C1_WriteRead
+#define I2C1_Host_Transfer I2C1_Transfer
+#define I2C1_Host_TransferSetup I2C1_TransferSetup
 #define I2C1_Host_ErrorGet I2C1_ErrorGet
 #define I2C1_Host_CallbackRegister I2C1_CallbackRegister
 #define I2C1_Host_IsBusy I2C1_IsBusy
+#define I2C1_Host_TransferDoneCallbackRegister I2C1_TransferDoneCallbackRegister
 
 
 
@@ -187,6 +252,57 @@ bool I2C1_Read(uint16_t address, uint8_t *data, size_t dataLength);
  */
 bool I2C1_WriteRead(uint16_t address, uint8_t *writeData, size_t writeLength, uint8_t *readData, size_t readLength);
 
+/**
+ * @ingroup i2c_host
+ * @brief This function starts a write, a read or a write followed by a read
+ *        through a Repeated start, like I2C1_Write(), I2C1_Read() and
+ *        I2C1_WriteRead(), and calls callback when that transfer ends.
+ *        A readLength of 0 makes it a write and a writeLength of 0 a read.
+ *
+ *        The callback runs once from I2C1_ISR after the Stop condition, or
+ *        from I2C1_ERROR_ISR after a bus collision reset, and gets the
+ *        transfer's error state and context. The transfer is closed by
+ *        then, so the next one can be started from inside the callback;
+ *        its Start waits in the module until BFRE sets, the BFRET time
+ *        after the Stop. The error state stays readable through
+ *        I2C1_ErrorGet() as well.
+ *
+ * @param [in] address     - 7-bit / 10-bit Client address.
+ * @param [in] writeData   - pointer to write data buffer.
+ * @param [in] writeLength - write data length in bytes.
+ * @param [out] readData    - pointer to read data buffer.
+ * @param [in] readLength  - read data length in bytes.
+ * @param [in] callback    - completion callback, may be NULL.
+ * @param [in] context     - passed to callback unchanged.
+ *
+ * @return
+ *         true  - The request was placed and callback will be called.
+ *         false - A transfer was already in progress. callback will not be
+ *                 called for this request.
+ */
+bool I2C1_Transfer(uint16_t address, uint8_t *writeData, size_t writeLength, uint8_t *readData, size_t readLength,
+        i2c_host_transfer_callback_t callback, void *context);
+
+/**
+ * @ingroup i2c_host
+ * @brief This function changes the SCL frequency.
+ *        I2C1BAUD and the FME divider are chosen for the fastest rate that
+ *        does not exceed setup->clkSpeed, with SCL = I2C1CLK / ((BAUD + 1) * 5),
+ *        or * 4 when FME is set. Rates above 400 kHz also switch the SCL and
+ *        SDA pads to Fast mode Plus slew. The module is restarted to load the
+ *        new settings, so this must be called with the bus idle.
+ *
+ * @param [in] setup      - requested SCL frequency in Hz, up to 1 MHz.
+ * @param [in] srcClkFreq - I2C1CLK source frequency in Hz (Fosc), or 0 for
+ *                          _XTAL_FREQ.
+ *
+ * @return
+ *         true  - The new SCL frequency is in effect.
+ *         false - A transfer is in progress, or the rate is above 1 MHz or
+ *                 too slow to reach from srcClkFreq. Nothing was changed.
+ */
+bool I2C1_TransferSetup(i2c_host_transfer_setup_t* setup, uint32_t srcClkFreq);
+
 /**
  * @ingroup i2c_host
  * @brief This function get the error occurred during I2C Transmit and Receive.
@@ -235,6 +351,59 @@ bool I2C1_IsBusy(void);
  */
 void I2C1_CallbackRegister(void (*callbackHandler)(void));
 
+/**
+ * @ingroup i2c_host
+ * @brief Setter function for the transfer done callback. It is called from
+ *        I2C1_ISR once the Stop condition of a transfer has completed, whether
+ *        the transfer succeeded or was ended by an error, so a new transfer
+ *        can be started from inside the callback. Every transfer ends here,
+ *        after the callback passed to I2C1_Transfer() if there was one.
+ * @param CallbackHandler - Pointer to custom Callback, NULL to unregister.
+ * @return void
+ */
+void I2C1_TransferDoneCallbackRegister(void (*callbackHandler)(void));
+
+#if I2C1_STATS
+/**
+ * @ingroup i2c_host
+ * @brief Copies the transfer counters and the latency histogram. Interrupts
+ *        are held off for the copy, so the snapshot is consistent.
+ *        Counters wrap at 2^32, and transfers longer than one TMR1 wrap
+ *        (52 ms at 40 MHz) are timed modulo the wrap.
+ * @param [out] stats - Snapshot.
+ * @return void
+ */
+void I2C1_StatsGet(i2c_host_stats_t *stats);
+
+/**
+ * @ingroup i2c_host
+ * @brief Zeroes the transfer counters and the latency histogram.
+ * @param void
+ * @return void
+ */
+void I2C1_StatsClear(void);
+#endif
+
+#if I2C1_TRACE
+/**
+ * @ingroup i2c_host
+ * @brief Copies the trace ring oldest event first, with interrupts held
+ *        off for the copy. Slots never written since the last clear come
+ *        first and have code I2C_TRACE_EMPTY.
+ * @param [out] events - I2C1_TRACE_SIZE entries.
+ * @return void
+ */
+void I2C1_TraceCopy(i2c_host_trace_event_t *events);
+
+/**
+ * @ingroup i2c_host
+ * @brief Empties the trace ring.
+ * @param void
+ * @return void
+ */
+void I2C1_TraceClear(void);
+#endif
+
 /**
  * @ingroup I2C1_host
  * @brief This function is ISR function for I2C1 Common interrupts
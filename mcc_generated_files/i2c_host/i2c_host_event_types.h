@@ -53,4 +53,69 @@ typedef struct
     i2c_host_error_t errorState; /**< Error State*/
 } i2c_host_event_status_t;
 
+/**
+ * @ingroup i2c_host_events
+ * @brief Number of latency histogram buckets. Bucket 0 holds transfers that
+ *        closed in under I2C_HOST_STATS_FIRST_US, each later bucket is twice
+ *        as wide as the one before, and the last one takes everything longer.
+ */
+#define I2C_HOST_STATS_BUCKETS 8
+
+/**
+ * @ingroup i2c_host_events
+ * @brief Upper edge of latency bucket 0 in microseconds.
+ */
+#define I2C_HOST_STATS_FIRST_US 100UL
+
+/**
+ * @ingroup i2c_host_events
+ * @struct i2c_host_stats_t
+ * @brief Snapshot of a host driver's transfer counters
+ */
+typedef struct
+{
+    uint32_t started; /**< Transfers accepted by Write, Read or WriteRead*/
+    uint32_t completed; /**< Transfers closed without an error*/
+    uint32_t rejectedBusy; /**< Calls refused because a transfer was in progress*/
+    uint32_t addrNacks; /**< Address bytes not acknowledged*/
+    uint32_t dataNacks; /**< Data bytes not acknowledged*/
+    uint32_t busCollisions; /**< Bus collisions*/
+    uint32_t timeouts; /**< Bus time-outs*/
+    uint32_t bytes; /**< Data bytes moved, addresses not counted*/
+    uint32_t latency[I2C_HOST_STATS_BUCKETS]; /**< Start to close time of every closed transfer*/
+} i2c_host_stats_t;
+
+/**
+ * @ingroup i2c_host_events
+ * @enum i2c_host_trace_code_t
+ * @brief Event codes of the trace buffer
+ */
+typedef enum
+{
+    I2C_TRACE_EMPTY,        /**< Slot not written since the last clear */
+    I2C_TRACE_START,        /**< Start requested; data 1 for a repeated Start */
+    I2C_TRACE_ADDRESS,      /**< Address byte loaded; data is the byte with R/W */
+    I2C_TRACE_TX,           /**< Data byte loaded for transmit */
+    I2C_TRACE_RX,           /**< Data byte received */
+    I2C_TRACE_NACK,         /**< NACK; data 0 for the address, 1 for data */
+    I2C_TRACE_COLLISION,    /**< Bus collision */
+    I2C_TRACE_TIMEOUT,      /**< Bus time-out */
+    I2C_TRACE_STOP,         /**< Stop; data 0 when requested, 1 once complete */
+    I2C_TRACE_CLOSE,        /**< Transfer closed; data is the i2c_host_error_t */
+} i2c_host_trace_code_t;
+
+/**
+ * @ingroup i2c_host_events
+ * @struct i2c_host_trace_event_t
+ * @brief One trace buffer entry. Four bytes in this order on every compiler,
+ *        which is the layout the host decoder reads.
+ */
+typedef struct
+{
+    uint8_t timeLow; /**< Free-running timer count when recorded, low byte*/
+    uint8_t timeHigh; /**< High byte*/
+    uint8_t code; /**< i2c_host_trace_code_t*/
+    uint8_t data; /**< Event argument*/
+} i2c_host_trace_event_t;
+
 #endif /* end of I2C_EVENT_TYPES_H */
\ No newline at end of file
@@ -54,6 +54,8 @@ typedef struct
     bool (*Write)(uint16_t address, uint8_t *data, size_t dataLength);
     bool (*Read)(uint16_t address, uint8_t *data, size_t dataLength);
     bool (*WriteRead)(uint16_t address, uint8_t *writeData, size_t writeLength, uint8_t *readData, size_t readLength);
+    bool (*Transfer)(uint16_t address, uint8_t *writeData, size_t writeLength, uint8_t *readData, size_t readLength,
+            i2c_host_transfer_callback_t callback, void *context);
     bool (*TransferSetup)(i2c_host_transfer_setup_t* setup, uint32_t srcClkFreq);
     i2c_host_error_t (*ErrorGet)(void);
     bool (*IsBusy)(void);
@@ -57,4 +57,14 @@ typedef struct
   uint32_t clkSpeed;            /**< I2C Clock Speed */
 } i2c_host_transfer_setup_t;
 
+/**
+ * @ingroup i2c_host_interface
+ * @typedef i2c_host_transfer_callback_t
+ * @brief Completion callback of a single transfer. It is called once, in
+ *        interrupt context, once the transfer has ended, with its result and
+ *        the context pointer given when it was started. The next transfer
+ *        may be started from inside it.
+ */
+typedef void (*i2c_host_transfer_callback_t)(i2c_host_error_t error, void *context);
+
 #endif // end of I2C_HOST_TYPES_H
\ No newline at end of file
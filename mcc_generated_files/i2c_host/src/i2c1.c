@@ -34,11 +34,45 @@
 #include <xc.h>
 #include "../../system/config_bits.h"
 #include "../i2c1.h"
+#if I2C1_STATS || I2C1_TRACE
+#include <string.h>
+#include "../../timer/tmr1.h"
+#endif
+
+/* Top of Fast mode and of Fast mode Plus, Hz */
+#define I2C1_FAST_SPEED 400000UL
+#define I2C1_FAST_PLUS_SPEED 1000000UL
+
+#if I2C1_STATS
+/* Upper edge of latency bucket 0 in TMR1 counts */
+#define I2C1_STATS_FIRST_COUNTS ((uint16_t) (I2C_HOST_STATS_FIRST_US * TMR1_FREQUENCY / 1000000UL))
+#endif
+
+#if I2C1_TRACE
+#if (I2C1_TRACE_SIZE & (I2C1_TRACE_SIZE - 1)) || I2C1_TRACE_SIZE > 256
+#error "I2C1_TRACE_SIZE must be a power of 2 up to 256"
+#endif
+/* A handful of moves and no lock: the I2C1 ISRs share one priority and a
+   Start is recorded before it is requested, while the bus is idle, so there
+   is only ever one writer. TMR1 is read inline, low byte first to latch
+   the high byte. */
+#define I2C1_TRACE_RECORD(eventCode, eventData) do { \
+        i2c_host_trace_event_t *traceEvent = &i2c1Trace[i2c1TraceHead]; \
+        traceEvent->timeLow = TMR1L; \
+        traceEvent->timeHigh = TMR1H; \
+        traceEvent->code = (eventCode); \
+        traceEvent->data = (uint8_t) (eventData); \
+        i2c1TraceHead = (uint8_t) ((i2c1TraceHead + 1) & (I2C1_TRACE_SIZE - 1)); \
+    } while (0)
+#else
+#define I2C1_TRACE_RECORD(eventCode, eventData)
+#endif
 
 /* I2C1 event system interfaces */
 static void I2C1_ReadStart(void);
 static void I2C1_WriteStart(void);
 static void I2C1_Close(void);
+static void I2C1_TransferEnd(void);
 static void I2C1_DefaultCallback(void);
 
 /* I2C1 interfaces */
@@ -47,7 +81,9 @@ static void I2C1_AddrTransmit(uint8_t addr);
 static void I2C1_DataTransmit(uint8_t data);
 static uint8_t I2C1_DataReceive(void);
 static void I2C1_CounterSet(uint16_t counter);
+#if I2C1_STATS
 static uint16_t I2C1_CounterGet(void);
+#endif
 static inline void I2C1_BusReset(void);
 static inline void I2C1_RestartEnable(void);
 static inline void I2C1_RestartDisable(void);
@@ -62,6 +98,15 @@ static inline void I2C1_InterruptsDisable(void);
 static inline void I2C1_InterruptsClear(void);
 static inline void I2C1_ErrorFlagsClear(void);
 static inline void I2C1_BufferClear(void);
+#if I2C1_DMA_TX
+static void I2C1_DmaInitialize(void);
+static void I2C1_DmaTxStart(void);
+static void I2C1_DmaTxStop(void);
+#endif
+#if I2C1_STATS
+static void I2C1_StatsPhaseEnd(void);
+static void I2C1_StatsClose(void);
+#endif
 
 /**
   Section: Driver Interface
@@ -72,7 +117,8 @@ const i2c_host_interface_t I2C1_Host = {
     .Write = I2C1_Write,
     .Read = I2C1_Read,
     .WriteRead = I2C1_WriteRead,
-    .TransferSetup = NULL,
+    .Transfer = I2C1_Transfer,
+    .TransferSetup = I2C1_TransferSetup,
     .ErrorGet = I2C1_ErrorGet,
     .IsBusy = I2C1_IsBusy,
     .CallbackRegister = I2C1_CallbackRegister,
@@ -83,7 +129,19 @@ const i2c_host_interface_t I2C1_Host = {
  Section: Private Variable Definitions
  */
 static void (*I2C1_Callback)(void) = NULL;
+static void (*I2C1_TransferDoneCallback)(void) = NULL;
+static i2c_host_transfer_callback_t I2C1_TransferCallback = NULL; /* Of the open transfer only */
+static void *I2C1_TransferContext;
 volatile i2c_host_event_status_t i2c1Status = {0};
+#if I2C1_STATS
+static i2c_host_stats_t i2c1Stats;
+static uint16_t i2c1StatsStart; /* TMR1 at the Start of the open transfer */
+static uint16_t i2c1StatsPhaseLength; /* I2C1CNT loaded for the current write or read */
+#endif
+#if I2C1_TRACE
+static i2c_host_trace_event_t i2c1Trace[I2C1_TRACE_SIZE];
+static uint8_t i2c1TraceHead; /* Next slot to write, also the oldest event once full */
+#endif
 
 /**
  Section: Public Interfaces
@@ -115,6 +173,9 @@ void I2C1_Initialize(void)
     RB1I2C = 0x51;
     /* Data PadReg Configuration */
     RB2I2C = 0x51;
+#if I2C1_DMA_TX
+    I2C1_DmaInitialize();
+#endif
     I2C1_InterruptsEnable();
 
     /* Silicon-Errata: Section: 1.3.2 */
@@ -154,7 +215,7 @@ void I2C1_Deinitialize(void)
 bool I2C1_Write(uint16_t address, uint8_t *data, size_t dataLength)
 {
     bool retStatus = false;
-    if (!I2C1_IsBusy())
+    if (!i2c1Status.busy)
     {
         i2c1Status.busy = true;
         i2c1Status.address = address;
@@ -164,16 +225,26 @@ bool I2C1_Write(uint16_t address, uint8_t *data, size_t dataLength)
         i2c1Status.readPtr = NULL;
         i2c1Status.readLength = 0;
         i2c1Status.errorState = I2C_ERROR_NONE;
+#if I2C1_STATS
+        i2c1Stats.started++;
+        i2c1StatsStart = TMR1_Read();
+#endif
         I2C1_WriteStart();
         retStatus = true;
     }
+#if I2C1_STATS
+    else
+    {
+        i2c1Stats.rejectedBusy++;
+    }
+#endif
     return retStatus;
 }
 
 bool I2C1_Read(uint16_t address, uint8_t *data, size_t dataLength)
 {
     bool retStatus = false;
-    if (!I2C1_IsBusy())
+    if (!i2c1Status.busy)
     {
         i2c1Status.busy = true;
         i2c1Status.address = address;
@@ -183,16 +254,26 @@ bool I2C1_Read(uint16_t address, uint8_t *data, size_t dataLength)
         i2c1Status.writePtr = NULL;
         i2c1Status.writeLength = 0;
         i2c1Status.errorState = I2C_ERROR_NONE;
+#if I2C1_STATS
+        i2c1Stats.started++;
+        i2c1StatsStart = TMR1_Read();
+#endif
         I2C1_ReadStart();
         retStatus = true;
     }
+#if I2C1_STATS
+    else
+    {
+        i2c1Stats.rejectedBusy++;
+    }
+#endif
     return retStatus;
 }
 
 bool I2C1_WriteRead(uint16_t address, uint8_t *writeData, size_t writeLength, uint8_t *readData, size_t readLength)
 {
     bool retStatus = false;
-    if (!I2C1_IsBusy())
+    if (!i2c1Status.busy)
     {
         i2c1Status.busy = true;
         i2c1Status.address = address;
@@ -202,12 +283,154 @@ bool I2C1_WriteRead(uint16_t address, uint8_t *writeData, size_t writeLength, ui
         i2c1Status.readPtr = readData;
         i2c1Status.readLength = readLength;
         i2c1Status.errorState = I2C_ERROR_NONE;
+#if I2C1_STATS
+        i2c1Stats.started++;
+        i2c1StatsStart = TMR1_Read();
+#endif
         I2C1_WriteStart();
         retStatus = true;
     }
+#if I2C1_STATS
+    else
+    {
+        i2c1Stats.rejectedBusy++;
+    }
+#endif
+    return retStatus;
+}
+
+bool I2C1_Transfer(uint16_t address, uint8_t *writeData, size_t writeLength, uint8_t *readData, size_t readLength,
+        i2c_host_transfer_callback_t callback, void *context)
+{
+    bool retStatus = false;
+    /* Only a transfer still open refuses the request: the module holds a
+       Start until BFRE sets, the BFRET time after the previous Stop */
+    if (!i2c1Status.busy)
+    {
+        /* Set before the Start goes out, the transfer may end in the next interrupt */
+        I2C1_TransferCallback = callback;
+        I2C1_TransferContext = context;
+        if (readLength == 0)
+        {
+            retStatus = I2C1_Write(address, writeData, writeLength);
+        }
+        else if (writeLength == 0)
+        {
+            retStatus = I2C1_Read(address, readData, readLength);
+        }
+        else
+        {
+            retStatus = I2C1_WriteRead(address, writeData, writeLength, readData, readLength);
+        }
+    }
+#if I2C1_STATS
+    else
+    {
+        i2c1Stats.rejectedBusy++;
+    }
+#endif
+    return retStatus;
+}
+
+bool I2C1_TransferSetup(i2c_host_transfer_setup_t* setup, uint32_t srcClkFreq)
+{
+    bool retStatus = false;
+    uint32_t clkSpeed = setup->clkSpeed;
+    uint32_t divider;
+    uint32_t fastDivider;
+    bool useFme;
+
+    if (srcClkFreq == 0U)
+    {
+        srcClkFreq = _XTAL_FREQ;
+    }
+    if (!I2C1_IsBusy() && (clkSpeed != 0U) && (clkSpeed <= I2C1_FAST_PLUS_SPEED))
+    {
+        /* Round the dividers up so SCL never runs faster than asked */
+        divider = (srcClkFreq + (clkSpeed * 5U) - 1U) / (clkSpeed * 5U);
+        fastDivider = (srcClkFreq + (clkSpeed * 4U) - 1U) / (clkSpeed * 4U);
+        /* FME only when /4 lands closer to clkSpeed than /5 */
+        useFme = (fastDivider * 4U) < (divider * 5U);
+        if (useFme)
+        {
+            divider = fastDivider;
+        }
+        if ((divider != 0U) && (divider <= 256U))
+        {
+            I2C1CON0bits.EN = 0;
+            I2C1BAUD = (uint8_t) (divider - 1U);
+            I2C1CON2bits.FME = useFme ? 1U : 0U;
+            RB1I2C = (clkSpeed > I2C1_FAST_SPEED) ? I2C1_PAD_FAST_PLUS : I2C1_PAD_FAST;
+            RB2I2C = (clkSpeed > I2C1_FAST_SPEED) ? I2C1_PAD_FAST_PLUS : I2C1_PAD_FAST;
+
+            /* Silicon-Errata: Section: 1.3.2 */
+            I2C1PIEbits.SCIE = 0;
+            I2C1PIEbits.PCIE = 0;
+            I2C1CON0bits.EN = 1;
+            __delay_us(1);
+            __nop();
+            __nop();
+            __nop();
+            __nop();
+            __nop();
+            __nop();
+            I2C1PIRbits.SCIF = 0;
+            I2C1PIRbits.PCIF = 0;
+            I2C1PIEbits.PCIE = 1;
+            retStatus = true;
+        }
+    }
     return retStatus;
 }
 
+#if I2C1_STATS
+void I2C1_StatsGet(i2c_host_stats_t *stats)
+{
+    uint8_t state = INTCON0bits.GIE;
+
+    INTCON0bits.GIE = 0;
+    *stats = i2c1Stats;
+    INTCON0bits.GIE = state;
+}
+
+void I2C1_StatsClear(void)
+{
+    uint8_t state = INTCON0bits.GIE;
+
+    INTCON0bits.GIE = 0;
+    memset(&i2c1Stats, 0, sizeof (i2c1Stats));
+    INTCON0bits.GIE = state;
+}
+#endif
+
+#if I2C1_TRACE
+void I2C1_TraceCopy(i2c_host_trace_event_t *events)
+{
+    uint8_t state = INTCON0bits.GIE;
+    uint8_t index;
+    uint16_t i;
+
+    INTCON0bits.GIE = 0;
+    index = i2c1TraceHead;
+    for (i = 0; i < I2C1_TRACE_SIZE; i++)
+    {
+        events[i] = i2c1Trace[index];
+        index = (uint8_t) ((index + 1) & (I2C1_TRACE_SIZE - 1));
+    }
+    INTCON0bits.GIE = state;
+}
+
+void I2C1_TraceClear(void)
+{
+    uint8_t state = INTCON0bits.GIE;
+
+    INTCON0bits.GIE = 0;
+    memset(i2c1Trace, 0, sizeof (i2c1Trace));
+    i2c1TraceHead = 0;
+    INTCON0bits.GIE = state;
+}
+#endif
+
 i2c_host_error_t I2C1_ErrorGet(void)
 {
     i2c_host_error_t retErrorState = i2c1Status.errorState;
@@ -228,11 +451,18 @@ void I2C1_CallbackRegister(void (*callbackHandler)(void))
     }
 }
 
+void I2C1_TransferDoneCallbackRegister(void (*callbackHandler)(void))
+{
+    I2C1_TransferDoneCallback = callbackHandler;
+}
+
 void I2C1_ISR()
 {
     if (I2C1PIEbits.PCIE && I2C1PIRbits.PCIF)
     {
+        I2C1_TRACE_RECORD(I2C_TRACE_STOP, 1);
         I2C1_Close();
+        I2C1_TransferEnd();
     }
     else if (I2C1PIEbits.CNTIE && I2C1PIRbits.CNTIF)
     {
@@ -242,6 +472,9 @@ void I2C1_ISR()
             i2c1Status.switchToRead = false;
             I2C1PIRbits.SCIF = 0;
             I2C1PIRbits.CNTIF = 0;
+#if I2C1_STATS
+            I2C1_StatsPhaseEnd();
+#endif
             I2C1_ReadStart();
         }
         else 
@@ -259,27 +492,46 @@ void I2C1_ISR()
 
 void I2C1_ERROR_ISR()
 {
+    bool reset = false;
+
     if (I2C1_IsBusCol())
     {
         i2c1Status.errorState = I2C_ERROR_BUS_COLLISION;
+#if I2C1_STATS
+        i2c1Stats.busCollisions++;
+#endif
+        I2C1_TRACE_RECORD(I2C_TRACE_COLLISION, 0);
         I2C1ERRbits.BCLIF = 0;
         I2C1_BusReset();
+        reset = true;
     }
     else if (I2C1_IsAddr() && I2C1_IsNack())
     {
         i2c1Status.errorState = I2C_ERROR_ADDR_NACK;
+#if I2C1_STATS
+        i2c1Stats.addrNacks++;
+#endif
+        I2C1_TRACE_RECORD(I2C_TRACE_NACK, 0);
         I2C1ERRbits.NACKIF = 0;
         I2C1_StopSend();
     }
     else if (I2C1_IsData() && I2C1_IsNack())
     {
         i2c1Status.errorState = I2C_ERROR_DATA_NACK;
+#if I2C1_STATS
+        i2c1Stats.dataNacks++;
+#endif
+        I2C1_TRACE_RECORD(I2C_TRACE_NACK, 1);
         I2C1ERRbits.NACKIF = 0;
         I2C1_StopSend();
     }
     else if (I2C1_IsBusTimeOut())
     {
         i2c1Status.errorState = I2C_ERROR_BUS_COLLISION;
+#if I2C1_STATS
+        i2c1Stats.timeouts++;
+#endif
+        I2C1_TRACE_RECORD(I2C_TRACE_TIMEOUT, 0);
         I2C1ERRbits.BTOIF = 0;
     }
     else
@@ -291,16 +543,28 @@ void I2C1_ERROR_ISR()
     {
         I2C1_Callback();
     }
+    if (reset)
+    {
+        /* The reset dropped the transfer without a Stop, so no PCIF will end it */
+        I2C1_Close();
+        I2C1_TransferEnd();
+    }
 }
 
 void I2C1_RX_ISR()
 {
-    *i2c1Status.readPtr++ = I2C1_DataReceive();
+    uint8_t data = I2C1_DataReceive();
+
+    *i2c1Status.readPtr++ = data;
+    I2C1_TRACE_RECORD(I2C_TRACE_RX, data);
 }
 
 void I2C1_TX_ISR()
 {
-    I2C1_DataTransmit(*i2c1Status.writePtr++);
+    uint8_t data = *i2c1Status.writePtr++;
+
+    I2C1_DataTransmit(data);
+    I2C1_TRACE_RECORD(I2C_TRACE_TX, data);
 }
 
 /**
@@ -308,32 +572,59 @@ void I2C1_TX_ISR()
  */
 static void I2C1_ReadStart(void)
 {
-    if (i2c1Status.readLength)
-    {
-        I2C1_CounterSet((uint16_t) i2c1Status.readLength);
-    }
+    /* Loaded even when 0, a count left over from a NACKed transfer would clock stale bytes */
+    I2C1_CounterSet((uint16_t) i2c1Status.readLength);
+#if I2C1_STATS
+    i2c1StatsPhaseLength = (uint16_t) i2c1Status.readLength;
+#endif
 
     I2C1_AddrTransmit((uint8_t) (i2c1Status.address << 1 | 1));
+    /* RSEN is still set when the write phase of a WriteRead hands over here */
+    I2C1_TRACE_RECORD(I2C_TRACE_START, I2C1CON0bits.RSEN);
+    I2C1_TRACE_RECORD(I2C_TRACE_ADDRESS, I2C1ADB1);
     I2C1_StartSend();
 }
 
 static void I2C1_WriteStart(void)
 {
+    /* Loaded even when 0, so an address-only probe sends a Stop right after the ACK */
+    I2C1_CounterSet((uint16_t) i2c1Status.writeLength);
     if (i2c1Status.writeLength)
     {
-        I2C1_CounterSet((uint16_t) i2c1Status.writeLength);
+#if I2C1_DMA_TX
+        I2C1_DmaTxStart();
+#endif
         if (i2c1Status.switchToRead)
         {
             I2C1_RestartEnable();
         }
     }
+#if I2C1_STATS
+    i2c1StatsPhaseLength = (uint16_t) i2c1Status.writeLength;
+#endif
 
     I2C1_AddrTransmit((uint8_t) (i2c1Status.address << 1));
+    /* Always a first Start, even when BFRE is still clear after the last Stop */
+    I2C1_TRACE_RECORD(I2C_TRACE_START, 0);
+    I2C1_TRACE_RECORD(I2C_TRACE_ADDRESS, I2C1ADB1);
     I2C1_StartSend();
 }
 
 static void I2C1_Close(void)
 {
+#if I2C1_STATS || I2C1_TRACE
+    /* Close runs again for the Stop that follows a count-reached close */
+    if (i2c1Status.busy)
+    {
+#if I2C1_STATS
+        I2C1_StatsClose();
+#endif
+        I2C1_TRACE_RECORD(I2C_TRACE_CLOSE, i2c1Status.errorState);
+    }
+#endif
+#if I2C1_DMA_TX
+    I2C1_DmaTxStop();
+#endif
     i2c1Status.busy = false;
     i2c1Status.address = 0xFF;
     i2c1Status.writePtr = NULL;
@@ -343,6 +634,24 @@ static void I2C1_Close(void)
     I2C1_BufferClear();
 }
 
+static void I2C1_TransferEnd(void)
+{
+    i2c_host_transfer_callback_t callback = I2C1_TransferCallback;
+
+    /* The transfer is closed, so the next one can be started from the callbacks;
+       its Start goes out once BFRE sets */
+    if (callback != NULL)
+    {
+        /* Cleared first, the callback may start a transfer with a new one */
+        I2C1_TransferCallback = NULL;
+        callback(i2c1Status.errorState, I2C1_TransferContext);
+    }
+    if (I2C1_TransferDoneCallback != NULL)
+    {
+        I2C1_TransferDoneCallback();
+    }
+}
+
 static void I2C1_DefaultCallback(void)
 {
     // Default Callback for Error Indication
@@ -377,13 +686,18 @@ static void I2C1_CounterSet(uint16_t counter)
     I2C1CNTL = (counter & 0x00FF);
 }
 
+#if I2C1_STATS
 static uint16_t I2C1_CounterGet(void)
 {
     return (uint16_t) ((I2C1CNTH << 8) | I2C1CNTL);
 }
+#endif
 
 static inline void I2C1_BusReset(void)
 {
+#if I2C1_DMA_TX
+    I2C1_DmaTxStop();
+#endif
     I2C1_InterruptsClear();
     I2C1_ErrorFlagsClear();
     I2C1_InterruptsDisable();
@@ -420,6 +734,7 @@ static inline void I2C1_RestartDisable(void)
 
 static void I2C1_StopSend(void)
 {
+    I2C1_TRACE_RECORD(I2C_TRACE_STOP, 0);
     I2C1_RestartDisable();
     I2C1CON1bits.P = 1;
 }
@@ -454,7 +769,12 @@ static inline void I2C1_InterruptsEnable(void)
     PIE7bits.I2C1IE = 1;
     PIE7bits.I2C1EIE = 1;
     PIE7bits.I2C1RXIE = 1;
+#if I2C1_DMA_TX
+    /* I2C1TXIF still triggers DMA1, it just no longer interrupts the CPU */
+    PIE7bits.I2C1TXIE = 0;
+#else
     PIE7bits.I2C1TXIE = 1;
+#endif
 
     I2C1PIEbits.PCIE = 1;
     I2C1PIEbits.RSCIE = 1;
@@ -488,4 +808,77 @@ static inline void I2C1_BufferClear(void)
 {
     I2C1STAT1 = 0x00;
     I2C1STAT1bits.CLRBF = 1;
-}
\ No newline at end of file
+}
+
+#if I2C1_DMA_TX
+static void I2C1_DmaInitialize(void)
+{
+    uint8_t state = INTCON0bits.GIE;
+
+    DMASELECT = 0x0;
+    DMAnCON0 = 0x0;
+    /* DMA1 gets the bus ahead of the CPU; the DMA cannot run until the priorities are locked */
+    ISRPR = 0x1;
+    MAINPR = 0x2;
+    DMA1PR = 0x0;
+    INTCON0bits.GIE = 0;
+    PRLOCK = 0x55;
+    PRLOCK = 0xAA;
+    PRLOCKbits.PRLOCKED = 1;
+    INTCON0bits.GIE = state;
+}
+
+static void I2C1_DmaTxStart(void)
+{
+    DMASELECT = 0x0;
+    DMAnCON0 = 0x0;
+    /* DMODE unchanged; DSTP not cleared; SMR GPR; SMODE incremented; SSTP SIRQEN cleared when the source count reloads;  */
+    DMAnCON1 = 0x3;
+    DMAnSSA = (__uint24) i2c1Status.writePtr;
+    DMAnSSZ = (uint16_t) i2c1Status.writeLength;
+    DMAnDSA = (uint16_t) &I2C1TXB;
+    DMAnDSZ = 0x1;
+    /* One byte per I2C1TXIF, no abort trigger */
+    DMAnSIRQ = I2C1_DMA_TX_TRIGGER;
+    DMAnAIRQ = 0x0;
+    /* EN enabled; SIRQEN enabled;  */
+    DMAnCON0 = 0xC0;
+}
+
+static void I2C1_DmaTxStop(void)
+{
+    DMASELECT = 0x0;
+    DMAnCON0 = 0x0;
+}
+#endif
+
+#if I2C1_STATS
+/* Bytes the module clocked out or in since I2C1CNT was loaded */
+static void I2C1_StatsPhaseEnd(void)
+{
+    if (i2c1StatsPhaseLength)
+    {
+        i2c1Stats.bytes += (uint16_t) (i2c1StatsPhaseLength - I2C1_CounterGet());
+        i2c1StatsPhaseLength = 0;
+    }
+}
+
+static void I2C1_StatsClose(void)
+{
+    uint16_t elapsed = (uint16_t) (TMR1_Read() - i2c1StatsStart);
+    uint16_t edge = I2C1_STATS_FIRST_COUNTS;
+    uint8_t bucket = 0;
+
+    I2C1_StatsPhaseEnd();
+    if (i2c1Status.errorState == I2C_ERROR_NONE)
+    {
+        i2c1Stats.completed++;
+    }
+    while (bucket < (I2C_HOST_STATS_BUCKETS - 1) && elapsed >= edge)
+    {
+        edge <<= 1;
+        bucket++;
+    }
+    i2c1Stats.latency[bucket]++;
+}
+#endif
\ No newline at end of file
@@ -35,6 +35,9 @@
 #ifndef CLOCK_H
 #define	CLOCK_H
 
+/* Fosc, not the crystal: CLOCK_Initialize runs EXTOSC through the 4x PLL
+   with NDIV 1, so 40 MHz holds only for a 10 MHz crystal. Delays and the
+   I2C1 baud rate are derived from this value. */
 #ifndef _XTAL_FREQ
 #define _XTAL_FREQ 40000000
 #endif
@@ -38,6 +38,16 @@
 
 #include "../system/clock.h"
 
+/**
+ * @ingroup systemdriver
+ * @brief 1: multi-vector interrupts (MVECEN = ON) with the I2C1 sources at
+ *        low priority, each entering its own ISR through the vector table.
+ *        0: single vector, sources polled by INTERRUPT_InterruptManager.
+ */
+#ifndef INTERRUPT_VECTORED
+#define INTERRUPT_VECTORED 0
+#endif
+
 #endif	/* CONFIG_BITS_H */
 /**
  End of File
@@ -41,13 +41,24 @@ void (*INT2_InterruptHandler)(void);
 
 void  INTERRUPT_Initialize (void)
 {
+#if INTERRUPT_VECTORED
+    // Enable Interrupt Priority Vectors; I2C1 byte traffic runs below the
+    // sources left at the default high priority
+    INTCON0bits.IPEN = 1;
+    INTCON0bits.GIEL = 1;
+    IPR7bits.I2C1EIP = 0;
+    IPR7bits.I2C1RXIP = 0;
+    IPR7bits.I2C1IP = 0;
+    IPR7bits.I2C1TXIP = 0;
+#else
     // Disable Interrupt Priority Vectors (16CXXX Compatibility Mode)
     INTCON0bits.IPEN = 0;
+#endif
 
     // Clear the interrupt flag
     // Set the external interrupt edge detect
     EXT_INT0_InterruptFlagClear();   
-    EXT_INT0_risingEdgeSet();    
+    EXT_INT0_fallingEdgeSet();    
     // Set Default Interrupt Handler
     INT0_SetInterruptHandler(INT0_DefaultInterruptHandler);
     // EXT_INT0_InterruptEnable();
@@ -70,6 +81,53 @@ void  INTERRUPT_Initialize (void)
 
 }
 
+#if INTERRUPT_VECTORED
+// Each source enters its own handler from the vector table, nothing is polled
+void __interrupt(irq(IRQ_I2C1E),base(8),low_priority) I2C1_ERROR_Vector(void)
+{
+    I2C1_ERROR_ISR();
+}
+
+void __interrupt(irq(IRQ_I2C1RX),base(8),low_priority) I2C1_RX_Vector(void)
+{
+    I2C1_RX_ISR();
+}
+
+void __interrupt(irq(IRQ_I2C1),base(8),low_priority) I2C1_Vector(void)
+{
+    I2C1_ISR();
+}
+
+void __interrupt(irq(IRQ_I2C1TX),base(8),low_priority) I2C1_TX_Vector(void)
+{
+    I2C1_TX_ISR();
+}
+
+void __interrupt(irq(IRQ_TMR0),base(8)) TMR0_Vector(void)
+{
+    TMR0_ISR();
+}
+
+void __interrupt(irq(IRQ_INT0),base(8)) INT0_Vector(void)
+{
+    INT0_ISR();
+}
+
+void __interrupt(irq(IRQ_INT1),base(8)) INT1_Vector(void)
+{
+    INT1_ISR();
+}
+
+void __interrupt(irq(IRQ_INT2),base(8)) INT2_Vector(void)
+{
+    INT2_ISR();
+}
+
+void __interrupt(irq(default),base(8)) Default_ISR(void)
+{
+    //Unhandled Interrupt
+}
+#else
 /**
  * @ingroup interrupt
  * @brief Executes whenever a high-priority interrupt is triggered. This routine checks the source of the interrupt and calls the relevant interrupt function.
@@ -96,11 +154,28 @@ void __interrupt() INTERRUPT_InterruptManager (void)
     {
         I2C1_TX_ISR();
     }
+    else if(PIE3bits.TMR0IE == 1 && PIR3bits.TMR0IF == 1)
+    {
+        TMR0_ISR();
+    }
+    else if(PIE1bits.INT0IE == 1 && PIR1bits.INT0IF == 1)
+    {
+        INT0_ISR();
+    }
+    else if(PIE6bits.INT1IE == 1 && PIR6bits.INT1IF == 1)
+    {
+        INT1_ISR();
+    }
+    else if(PIE10bits.INT2IE == 1 && PIR10bits.INT2IF == 1)
+    {
+        INT2_ISR();
+    }
     else
     {
         //Unhandled Interrupt
     }
 }
+#endif
 
 void INT0_ISR(void)
 {
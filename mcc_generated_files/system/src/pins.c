@@ -61,7 +61,7 @@ void PIN_MANAGER_Initialize(void)
     ANSELx registers
     */
     ANSELA = 0xFF;
-    ANSELB = 0xF9;
+    ANSELB = 0xF8;
     ANSELC = 0xFF;
     ANSELD = 0xFF;
     ANSELE = 0x7;
@@ -71,7 +71,7 @@ void PIN_MANAGER_Initialize(void)
     WPUx registers
     */
     WPUA = 0x0;
-    WPUB = 0x6;
+    WPUB = 0x7;
     WPUC = 0x0;
     WPUD = 0x0;
     WPUE = 0x0;
@@ -121,6 +121,7 @@ void PIN_MANAGER_Initialize(void)
     RB1PPS = 0x37;  //RB1->I2C1:SCL1;
     I2C1SDAPPS = 0xA;  //RB2->I2C1:SDA1;
     RB2PPS = 0x38;  //RB2->I2C1:SDA1;
+    INT0PPS = 0x8;  //RB0->INTERRUPT MANAGER:INT0;
 
    /**
     IOCx registers 
@@ -43,6 +43,8 @@ void SYSTEM_Initialize(void)
     CLOCK_Initialize();
     PIN_MANAGER_Initialize();
     I2C1_Host_Initialize();
+    TMR0_Initialize();
+    TMR1_Initialize();
     INTERRUPT_Initialize();
 }
 
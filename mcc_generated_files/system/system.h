@@ -43,6 +43,8 @@
 #include "../system/clock.h"
 #include "../system/pins.h"
 #include "../i2c_host/i2c1.h"
+#include "../timer/tmr0.h"
+#include "../timer/tmr1.h"
 #include "../system/interrupt.h"
 
 /**
@@ -0,0 +1,74 @@
+/**
+ * TMR0 Generated Driver File
+ *
+ * @file tmr0.c
+ *
+ * @ingroup tmr0
+ *
+ * @brief This file contains the API implementation for the TMR0 driver.
+ *
+ * @version TMR0 Driver Version 2.0.0
+ */
+
+/*
+ [2024] Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip 
+    software and any derivatives exclusively with Microchip products. 
+    You are responsible for complying with 3rd party license terms  
+    applicable to your use of 3rd party software (including open source  
+    software) that may accompany Microchip software. SOFTWARE IS ?AS IS.? 
+    NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS 
+    SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,  
+    MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT 
+    WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY 
+    KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF 
+    MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE 
+    FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP?S 
+    TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL NOT 
+    EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR 
+    THIS SOFTWARE.
+*/
+
+#include <xc.h>
+#include "../tmr0.h"
+
+static void (*TMR0_OverflowCallback)(void) = NULL;
+
+void TMR0_Initialize(void)
+{
+    /* T0CS LFINTOSC; T0CKPS 1:1; T0ASYNC not synchronized, runs in Sleep;  */
+    T0CON1 = 0x90;
+    /* 31 kHz / 31 = 1 kHz */
+    TMR0H = 0x1E;
+    TMR0L = 0x0;
+    PIR3bits.TMR0IF = 0;
+    PIE3bits.TMR0IE = 1;
+    /* T0OUTPS 1:1; T0EN disabled; T016BIT 8-bit;  */
+    T0CON0 = 0x0;
+}
+
+void TMR0_Start(void)
+{
+    T0CON0bits.EN = 1;
+}
+
+void TMR0_Stop(void)
+{
+    T0CON0bits.EN = 0;
+}
+
+void TMR0_OverflowCallbackRegister(void (*CallbackHandler)(void))
+{
+    TMR0_OverflowCallback = CallbackHandler;
+}
+
+void TMR0_ISR(void)
+{
+    PIR3bits.TMR0IF = 0;
+    if (TMR0_OverflowCallback != NULL)
+    {
+        TMR0_OverflowCallback();
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * TMR1 Generated Driver File
+ *
+ * @file tmr1.c
+ *
+ * @ingroup tmr1
+ *
+ * @brief This file contains the API implementation for the TMR1 driver.
+ *
+ * @version TMR1 Driver Version 4.0.0
+ */
+
+/*
+ [2024] Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip 
+    software and any derivatives exclusively with Microchip products. 
+    You are responsible for complying with 3rd party license terms  
+    applicable to your use of 3rd party software (including open source  
+    software) that may accompany Microchip software. SOFTWARE IS ?AS IS.? 
+    NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS 
+    SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,  
+    MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT 
+    WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY 
+    KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF 
+    MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE 
+    FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP?S 
+    TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL NOT 
+    EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR 
+    THIS SOFTWARE.
+*/
+
+#include <xc.h>
+#include "../tmr1.h"
+
+void TMR1_Initialize(void)
+{
+    /* T1CON is written last, the timer is stopped until then */
+    T1CON = 0x0;
+    /* GE disabled; GTM disabled; GPOL low; GGO done; GSPM disabled;  */
+    T1GCON = 0x0;
+    /* GSS T1G_pin;  */
+    T1GATE = 0x0;
+    /* CS FOSC/4;  */
+    T1CLK = 0x1;
+    TMR1H = 0x0;
+    TMR1L = 0x0;
+    /* CKPS 1:8; NOT_SYNC synchronize; RD16 enabled; ON enabled;  */
+    T1CON = 0x33;
+}
+
+void TMR1_Start(void)
+{
+    T1CONbits.ON = 1;
+}
+
+void TMR1_Stop(void)
+{
+    T1CONbits.ON = 0;
+}
+
+uint16_t TMR1_Read(void)
+{
+    uint8_t readValLow = TMR1L;
+    uint8_t readValHigh = TMR1H;
+
+    return (uint16_t) ((readValHigh << 8) | readValLow);
+}
+
+void TMR1_Write(uint16_t timerVal)
+{
+    TMR1H = (uint8_t) (timerVal >> 8);
+    TMR1L = (uint8_t) timerVal;
+}
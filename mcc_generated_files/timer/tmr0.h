@@ -0,0 +1,88 @@
+/**
+ * TMR0 Generated Driver API Header File
+ *
+ * @file tmr0.h
+ *
+ * @defgroup tmr0 TMR0
+ *
+ * @brief This file contains API prototypes and other data types for the TMR0 module.
+ *
+ * @version TMR0 Driver Version 2.0.0
+ */
+
+/*
+ [2024] Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip 
+    software and any derivatives exclusively with Microchip products. 
+    You are responsible for complying with 3rd party license terms  
+    applicable to your use of 3rd party software (including open source  
+    software) that may accompany Microchip software. SOFTWARE IS ?AS IS.? 
+    NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS 
+    SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,  
+    MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT 
+    WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY 
+    KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF 
+    MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE 
+    FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP?S 
+    TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL NOT 
+    EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR 
+    THIS SOFTWARE.
+*/
+
+#ifndef TMR0_H
+#define TMR0_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @ingroup tmr0
+ * @brief Period of the TMR0 overflow interrupt in milliseconds.
+ *        TMR0 counts LFINTOSC, so it keeps running while the CPU sleeps.
+ */
+#define TMR0_PERIOD_MS 1
+
+/**
+ * @ingroup tmr0
+ * @brief Initializes TMR0 for a 1 ms period interrupt. The timer is left stopped.
+ * @param None.
+ * @return None.
+ */
+void TMR0_Initialize(void);
+
+/**
+ * @ingroup tmr0
+ * @brief Starts TMR0.
+ * @param None.
+ * @return None.
+ */
+void TMR0_Start(void);
+
+/**
+ * @ingroup tmr0
+ * @brief Stops TMR0.
+ * @param None.
+ * @return None.
+ */
+void TMR0_Stop(void);
+
+/**
+ * @ingroup tmr0
+ * @brief Setter function for the TMR0 overflow callback. It is called from
+ *        interrupt context once per period.
+ * @param CallbackHandler - Pointer to the custom callback.
+ * @return None.
+ */
+void TMR0_OverflowCallbackRegister(void (*CallbackHandler)(void));
+
+/**
+ * @ingroup tmr0
+ * @brief Interrupt Service Routine of TMR0, called from INTERRUPT_InterruptManager.
+ * @param None.
+ * @return None.
+ */
+void TMR0_ISR(void);
+
+#endif //TMR0_H
@@ -0,0 +1,89 @@
+/**
+ * TMR1 Generated Driver API Header File
+ *
+ * @file tmr1.h
+ *
+ * @defgroup tmr1 TMR1
+ *
+ * @brief This file contains API prototypes and other data types for the TMR1 module.
+ *
+ * @version TMR1 Driver Version 4.0.0
+ */
+
+/*
+ [2024] Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip 
+    software and any derivatives exclusively with Microchip products. 
+    You are responsible for complying with 3rd party license terms  
+    applicable to your use of 3rd party software (including open source  
+    software) that may accompany Microchip software. SOFTWARE IS ?AS IS.? 
+    NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS 
+    SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,  
+    MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT 
+    WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY 
+    KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF 
+    MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE 
+    FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP?S 
+    TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL NOT 
+    EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR 
+    THIS SOFTWARE.
+*/
+
+#ifndef TMR1_H
+#define TMR1_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../system/clock.h"
+
+/**
+ * @ingroup tmr1
+ * @brief Count rate of TMR1 in Hz. TMR1 counts Fosc/4 through the 1:8
+ *        prescaler, free-running, so it wraps every 65536 counts (52 ms at 40 MHz).
+ */
+#define TMR1_FREQUENCY (_XTAL_FREQ / 4UL / 8UL)
+
+/**
+ * @ingroup tmr1
+ * @brief Initializes TMR1 as a free-running 16-bit counter with no interrupt, and starts it.
+ * @param None.
+ * @return None.
+ */
+void TMR1_Initialize(void);
+
+/**
+ * @ingroup tmr1
+ * @brief Starts TMR1.
+ * @param None.
+ * @return None.
+ */
+void TMR1_Start(void);
+
+/**
+ * @ingroup tmr1
+ * @brief Stops TMR1.
+ * @param None.
+ * @return None.
+ */
+void TMR1_Stop(void);
+
+/**
+ * @ingroup tmr1
+ * @brief Reads the 16-bit count. TMR1H is latched when TMR1L is read, so the
+ *        two bytes always belong together. Safe to call from interrupt context.
+ * @param None.
+ * @return Current count.
+ */
+uint16_t TMR1_Read(void);
+
+/**
+ * @ingroup tmr1
+ * @brief Writes the 16-bit count.
+ * @param timerVal - New count.
+ * @return None.
+ */
+void TMR1_Write(uint16_t timerVal);
+
+#endif //TMR1_H
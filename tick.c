@@ -0,0 +1,86 @@
+/**
+ * Tick Service Source File
+ *
+ * @file tick.c
+ *
+ * @ingroup tick
+ *
+ * @brief The tick is written by the TMR0 interrupt only. Timers are started,
+ *        stopped and run from the main loop, so they need no locking.
+ */
+
+#include "tick.h"
+#include "mcc_generated_files/system/system.h"
+
+#if defined(__XC8)
+#define TICK_CRITICAL_ENTER() uint8_t gieSave = INTERRUPT_GlobalInterruptStatus(); INTERRUPT_GlobalInterruptDisable()
+#define TICK_CRITICAL_EXIT() INTCON0bits.GIE = gieSave
+#else
+// The host fake clock advances from the main loop, nothing to mask
+#define TICK_CRITICAL_ENTER()
+#define TICK_CRITICAL_EXIT()
+#endif
+
+static volatile uint32_t tickCount = 0;
+static tick_timer_t *timerList = NULL;
+
+void Tick_Initialize(void) {
+    TICK_CRITICAL_ENTER();
+    tickCount = 0;
+    TICK_CRITICAL_EXIT();
+    TMR0_OverflowCallbackRegister(Tick_Increment);
+    TMR0_Start();
+}
+
+void Tick_Increment(void) {
+    tickCount++;
+}
+
+uint32_t Tick_Get(void) {
+    uint32_t now;
+
+    // Four byte read on an 8-bit core, keep the interrupt from tearing it
+    TICK_CRITICAL_ENTER();
+    now = tickCount;
+    TICK_CRITICAL_EXIT();
+    return now;
+}
+
+bool Tick_Elapsed(uint32_t since, uint32_t ticks) {
+    return (uint32_t) (Tick_Get() - since) >= ticks;
+}
+
+void Tick_TimerStart(tick_timer_t *timer, uint32_t delay, uint32_t period, void (*callback)(void *context), void *context) {
+    timer->due = Tick_Get() + delay;
+    timer->period = period;
+    timer->callback = callback;
+    timer->context = context;
+    timer->active = true;
+    if (!timer->linked) {
+        timer->next = timerList;
+        timerList = timer;
+        timer->linked = true;
+    }
+}
+
+void Tick_TimerStop(tick_timer_t *timer) {
+    timer->active = false;
+}
+
+bool Tick_TimerActive(const tick_timer_t *timer) {
+    return timer->active;
+}
+
+void Tick_Tasks(void) {
+    uint32_t now = Tick_Get();
+
+    for (tick_timer_t *timer = timerList; timer != NULL; timer = timer->next) {
+        if (!timer->active || (int32_t) (now - timer->due) < 0)
+            continue;
+        if (timer->period != 0)
+            timer->due += timer->period; // Keeps the phase if Tasks ran late
+        else
+            timer->active = false;
+        timer->callback(timer->context); // May restart or stop this timer
+    }
+}
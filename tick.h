@@ -0,0 +1,109 @@
+/**
+ * Tick Service Header File
+ *
+ * @file tick.h
+ *
+ * @defgroup tick TICK
+ *
+ * @brief Monotonic millisecond tick counted by the TMR0 interrupt, and
+ *        software timers run from the main loop. Waits become timers, so
+ *        the CPU is free for other work, or Sleep, between them.
+ */
+
+#ifndef TICK_H
+#define TICK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @ingroup tick
+ * @struct tick_timer_t
+ * @brief One-shot or periodic software timer. Caller-allocated and linked
+ *        into the service on first start, so it must have static storage.
+ */
+typedef struct tick_timer {
+    uint32_t due; /**< Tick at which the callback runs next*/
+    uint32_t period; /**< Ticks between runs, 0 for one-shot*/
+    void (*callback)(void *context);
+    void *context;
+    bool active;
+    bool linked; /**< Already in the service's list*/
+    struct tick_timer *next;
+} tick_timer_t;
+
+/**
+ * @ingroup tick
+ * @brief Zeroes the tick and starts TMR0 counting it.
+ * @param None.
+ * @return None.
+ */
+void Tick_Initialize(void);
+
+/**
+ * @ingroup tick
+ * @brief Advances the tick by one. Registered as the TMR0 overflow callback.
+ * @param None.
+ * @return None.
+ */
+void Tick_Increment(void);
+
+/**
+ * @ingroup tick
+ * @brief Milliseconds since Tick_Initialize(). Wraps after 49 days; compare
+ *        with Tick_Elapsed() rather than directly.
+ * @param None.
+ * @return Current tick.
+ */
+uint32_t Tick_Get(void);
+
+/**
+ * @ingroup tick
+ * @brief Checks whether ticks have passed since a tick read with Tick_Get().
+ * @param since - Earlier tick.
+ * @param ticks - Interval.
+ * @retval true - At least ticks have passed.
+ * @retval false - Still waiting.
+ */
+bool Tick_Elapsed(uint32_t since, uint32_t ticks);
+
+/**
+ * @ingroup tick
+ * @brief (Re)starts a timer. The callback runs from Tick_Tasks() delay
+ *        ticks from now, then every period ticks unless period is 0.
+ * @param timer - Timer to start.
+ * @param delay - Ticks to the first run.
+ * @param period - Ticks between later runs, 0 for one-shot.
+ * @param callback - Function to run.
+ * @param context - Passed to callback.
+ * @return None.
+ */
+void Tick_TimerStart(tick_timer_t *timer, uint32_t delay, uint32_t period, void (*callback)(void *context), void *context);
+
+/**
+ * @ingroup tick
+ * @brief Stops a timer; a stopped timer can be started again.
+ * @param timer - Timer to stop.
+ * @return None.
+ */
+void Tick_TimerStop(tick_timer_t *timer);
+
+/**
+ * @ingroup tick
+ * @brief Checks whether a timer is still going to run.
+ * @param timer - Timer to check.
+ * @retval true - Timer is running.
+ * @retval false - Timer was stopped or a one-shot has fired.
+ */
+bool Tick_TimerActive(const tick_timer_t *timer);
+
+/**
+ * @ingroup tick
+ * @brief Runs the callbacks of due timers. Call from the main loop.
+ * @param None.
+ * @return None.
+ */
+void Tick_Tasks(void);
+
+#endif /* TICK_H */